@@ -1,7 +1,14 @@
 #include <talon/talon.hpp>
 
+#include "src/core/asset_pack_format.hpp"
+
+#include <algorithm>
 #include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace fs = std::filesystem;
 using namespace std::literals;
@@ -29,18 +36,73 @@ auto generate_moc_files(std::initializer_list<std::string_view> relative_paths)
     }
 }
 
-auto copy_resources_to_build(talon::workspace &workspace) -> void
+auto pack_resources_to_build(talon::workspace &workspace) -> void
 {
     const auto build = workspace.root / "build";
     fs::create_directories(build);
 
-    const auto banners_dst = build / "banners";
-    const auto banners_src = workspace.root / "resources" / "banners";
-    if (fs::exists(banners_src)) fs::copy(banners_src, banners_dst, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+    struct Packed_File {
+        std::string name;
+        std::string data;
+    };
+
+    std::vector<Packed_File> files;
+    for (const auto directory : {"banners"sv, "icons"sv}) {
+        const auto source = workspace.root / "resources" / directory;
+        if (!fs::exists(source)) continue;
+
+        for (const auto &entry : fs::recursive_directory_iterator{source}) {
+            if (!entry.is_regular_file()) continue;
+
+            auto input = std::ifstream{entry.path(), std::ios::binary};
+            files.push_back({.name = (fs::path{directory} / fs::relative(entry.path(), source)).generic_string(),
+                             .data = std::string{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}}});
+        }
+    }
+
+    // the reader binary searches the index
+    std::ranges::sort(files, {}, &Packed_File::name);
+
+    const auto align = [](std::uint64_t offset) {
+        return (offset + core::ASSET_PACK_ALIGNMENT - 1) / core::ASSET_PACK_ALIGNMENT * core::ASSET_PACK_ALIGNMENT;
+    };
+
+    std::string names;
+    std::vector<core::Asset_Pack_Entry> entries;
+    for (const auto &file : files) {
+        entries.push_back({.name_offset = static_cast<std::uint32_t>(names.size()),
+                           .name_length = static_cast<std::uint32_t>(file.name.size()),
+                           .data_offset = 0,
+                           .data_size = file.data.size(),
+                           .hash = core::asset_hash(file.data)});
+        names += file.name;
+    }
+
+    auto offset = align(sizeof(core::Asset_Pack_Header) + entries.size() * sizeof(core::Asset_Pack_Entry) + names.size());
+    for (auto &entry : entries) {
+        entry.data_offset = offset;
+        offset = align(offset + entry.data_size);
+    }
+
+    const auto header = core::Asset_Pack_Header{.magic = core::ASSET_PACK_MAGIC,
+                                                .version = core::ASSET_PACK_VERSION,
+                                                .entry_count = static_cast<std::uint32_t>(entries.size()),
+                                                .names_size = static_cast<std::uint32_t>(names.size())};
+
+    const auto output_path = build / core::ASSET_PACK_FILE_NAME;
+    auto output = std::ofstream{output_path, std::ios::binary | std::ios::trunc};
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char *>(entries.data()),
+                 static_cast<std::streamsize>(entries.size() * sizeof(core::Asset_Pack_Entry)));
+    output.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const auto padding = entries[i].data_offset - static_cast<std::uint64_t>(output.tellp());
+        output.write(std::string(padding, '\0').data(), static_cast<std::streamsize>(padding));
+        output.write(files[i].data.data(), static_cast<std::streamsize>(files[i].data.size()));
+    }
 
-    const auto icons_dst = build / "icons";
-    const auto icons_src = workspace.root / "resources" / "icons";
-    if (fs::exists(icons_src)) fs::copy(icons_src, icons_dst, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+    std::printf("packed %zu assets -> %s\n", files.size(), output_path.string().data());
 }
 
 auto maybe_deploy_qt_deps(const bool needs_deployment) -> void
@@ -111,11 +173,12 @@ auto build(talon::arguments args) -> void
     set_build_options(args, &workspace);
 
     generate_moc_files({"ui/window.hpp", "ui/updater.hpp", "ui/login_worker.hpp", "ui/add_account_dialog.hpp", "ui/theme_editor.hpp",
-                        "ui/title_bar.hpp", "ui/misc_bar.hpp", "ui/control_bar.hpp"});
+                        "ui/title_bar.hpp", "ui/misc_bar.hpp", "ui/control_bar.hpp", "core/account_store.hpp",
+                        "core/theme_service.hpp", "ui/accounts_table_model.hpp"});
 
     // FIXME yeah this doesnt really work if the build folder is there lol
     const bool needs_qt_deps = !fs::exists(workspace.root / "build");
-    copy_resources_to_build(workspace);
+    pack_resources_to_build(workspace);
 
     workspace.build();
     maybe_deploy_qt_deps(needs_qt_deps);
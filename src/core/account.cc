@@ -3,6 +3,18 @@
 // =================================================================================
 
 #include "account.hpp"
+#include "account_columns.hpp"
+#include "account_journal.hpp"
+#include "account_reader.hpp"
+#include "binary_snapshot.hpp"
+
+#include <QFile>
+#include <QRandomGenerator>
+#include <QSet>
+
+#include <limits>
+
+#include <string_view>
 
 using namespace std::literals;
 
@@ -10,79 +22,187 @@ namespace core {
 
 Account_Config::Account_Config()
     : Config{"accounts.toml"}
+    , journal_{std::make_unique<Account_Journal>(path())}
 {
 }
 
-auto Account_Config::get_accounts() const -> QVector<Account>
+Account_Config::~Account_Config() = default;
+
+auto generate_account_id() -> Account_Id
 {
-    QVector<Account> accounts_list;
-    auto config = load();
+    Account_Id id = 0;
+    while (id == 0) id = QRandomGenerator::global()->generate64() & static_cast<Account_Id>(std::numeric_limits<std::int64_t>::max());
+    return id;
+}
 
-    const auto accounts_node = config["accounts"];
-    if (!accounts_node.is_array_of_tables()) return accounts_list;
+auto accounts_from_table(const toml::table &config) -> QVector<Account>
+{
+    QVector<Account> entries;
 
-    for (const auto &table : *accounts_node.as_array()) {
-        if (!table.is_table()) continue;
-        const auto *tbl_ptr = table.as_table();
+    const auto *accounts_array = config.get_as<toml::array>("accounts");
+    if (!accounts_array) return entries;
 
-        Account acc;
-        acc.note = QString::fromStdString(tbl_ptr->get("note")->value_or(""s));
-        acc.username = QString::fromStdString(tbl_ptr->get("username")->value_or(""s));
-        acc.password = QString::fromStdString(tbl_ptr->get("password")->value_or(""s));
+    entries.reserve(static_cast<qsizetype>(accounts_array->size()));
+    for (const auto &node : *accounts_array) {
+        const auto *table = node.as_table();
 
-        if (!acc.username.isEmpty() && !acc.password.isEmpty()) accounts_list.append(acc);
+        Account acc;
+        if (table) {
+            const auto id = (*table)["id"].value_or(std::int64_t{0});
+            acc.id = id > 0 ? static_cast<Account_Id>(id) : 0;
+            acc.note = QString::fromStdString((*table)["note"].value_or(""s));
+            acc.username = QString::fromStdString((*table)["username"].value_or(""s));
+            acc.password = QString::fromStdString((*table)["password"].value_or(""s));
+        }
+
+        entries.append(std::move(acc));
     }
 
-    return accounts_list;
+    return entries;
 }
 
-auto Account_Config::add_account(const Account &account) -> bool
+auto account_to_table(const Account &account) -> toml::table
 {
-    toml::table config = Config::load();
+    toml::table table;
+    table.insert("id", static_cast<std::int64_t>(account.id));
+    table.insert("note", account.note.toStdString());
+    table.insert("username", account.username.toStdString());
+    table.insert("password", account.password.toStdString());
+    return table;
+}
 
-    auto *accounts_array = config.get_as<toml::array>("accounts");
-    if (!accounts_array) {
-        config.insert_or_assign("accounts", toml::array{});
-        accounts_array = config.get_as<toml::array>("accounts");
+auto Account_Config::get_accounts() const -> Account_Columns
+{
+    auto accounts = journal_->replay([this](std::int64_t *sequence) {
+        const auto view = [](std::string_view value) { return QUtf8StringView{value.data(), static_cast<qsizetype>(value.size())}; };
+
+        Account_Columns loaded;
+        load_entries(
+            [&](const Account_Fields &fields) {
+                loaded.append(fields.id, view(fields.note), view(fields.username), view(fields.password));
+            },
+            sequence);
+        return loaded;
+    });
+
+    // files from before IDs existed (or edited by hand) get IDs assigned and persisted once
+    QSet<Account_Id> seen;
+    seen.reserve(accounts.size());
+    bool assigned = false;
+    for (int i = 0; i < accounts.size(); ++i) {
+        auto id = accounts.id(i);
+        if (id == 0 || seen.contains(id)) {
+            do {
+                id = generate_account_id();
+            } while (seen.contains(id));
+            accounts.set_id(i, id);
+            assigned = true;
+        }
+        seen.insert(id);
     }
+    if (assigned) journal_->checkpoint(accounts.to_accounts());
 
-    if (!accounts_array) return false;
+    QVector<bool> incomplete(accounts.size(), false);
+    for (int i = 0; i < accounts.size(); ++i) {
+        using Field = Account_Columns::Field;
+        incomplete[i] = accounts.field(i, Field::Username).isEmpty() || accounts.field(i, Field::Password).isEmpty();
+    }
+    accounts.remove_marked(incomplete);
 
-    toml::table new_account_table;
-    new_account_table.insert("note", account.note.toStdString());
-    new_account_table.insert("username", account.username.toStdString());
-    new_account_table.insert("password", account.password.toStdString());
+    return accounts;
+}
 
-    accounts_array->push_back(new_account_table);
-    return save(config);
+auto Account_Config::add_account(Account account) -> bool
+{
+    if (account.id == 0) account.id = generate_account_id();
+    return journal_->append({.op = Journal_Op::Add, .account = std::move(account)});
 }
 
-auto Account_Config::update_account(int index, const Account &account) -> bool
+auto Account_Config::update_account(Account_Id id, const Account &account) -> bool
 {
-    auto config = load();
+    auto record = Journal_Record{.op = Journal_Op::Update, .account = account};
+    record.account.id = id;
+    return journal_->append(std::move(record));
+}
 
-    auto *accounts_array = config.get_as<toml::array>("accounts");
-    if (!accounts_array || index < 0 || static_cast<size_t>(index) >= accounts_array->size()) { return false; }
+auto Account_Config::remove_account(Account_Id id) -> bool
+{
+    auto record = Journal_Record{.op = Journal_Op::Remove, .account = {}};
+    record.account.id = id;
+    return journal_->append(std::move(record));
+}
 
-    auto *table_to_update = accounts_array->at(index).as_table();
-    if (!table_to_update) return false;
+auto Account_Config::commit(const QVector<Journal_Record> &records) -> bool
+{
+    return journal_->append(records);
+}
 
-    table_to_update->insert_or_assign("note", account.note.toStdString());
-    table_to_update->insert_or_assign("username", account.username.toStdString());
-    table_to_update->insert_or_assign("password", account.password.toStdString());
+auto Account_Config::load_entries(const std::function<void(const Account_Fields &)> &on_account, std::int64_t *sequence) const -> void
+{
+    const auto source = Snapshot_Source::of(path());
+    const auto binary_path = Binary_Snapshot::path_for(path());
+
+    {
+        const auto snapshot = Binary_Snapshot{binary_path};
+        if (snapshot.matches(source)) {
+            const auto view = [&snapshot](int index, Binary_Snapshot::Field field) {
+                const auto value = snapshot.field(index, field);
+                return std::string_view{reinterpret_cast<const char *>(value.data()), static_cast<std::size_t>(value.size())};
+            };
+
+            *sequence = snapshot.sequence();
+            for (int i = 0; i < snapshot.size(); ++i) {
+                on_account({.id = snapshot.id(i),
+                            .note = view(i, Binary_Snapshot::Field::Note),
+                            .username = view(i, Binary_Snapshot::Field::Username),
+                            .password = view(i, Binary_Snapshot::Field::Password)});
+            }
+            return;
+        }
+    }
 
-    return save(config);
+    // the TOML file is new or was edited by hand, so read it and refresh the mirror; this
+    // happens once per outside edit, so the decoded entries are simply encoded back
+    const auto entries = read_entries(sequence);
+    Binary_Snapshot::write(binary_path, entries, source, *sequence);
+
+    for (const auto &entry : entries) {
+        const auto note = entry.note.toUtf8();
+        const auto username = entry.username.toUtf8();
+        const auto password = entry.password.toUtf8();
+        on_account({.id = entry.id,
+                    .note = std::string_view{note.constData(), static_cast<std::size_t>(note.size())},
+                    .username = std::string_view{username.constData(), static_cast<std::size_t>(username.size())},
+                    .password = std::string_view{password.constData(), static_cast<std::size_t>(password.size())}});
+    }
 }
 
-auto Account_Config::remove_account(int index) -> bool
+auto Account_Config::read_entries(std::int64_t *sequence) const -> QVector<Account>
 {
-    auto config = load();
+    QVector<Account> entries;
+
+    auto file = QFile{path()};
+    if (!file.open(QIODevice::ReadOnly)) return entries;
+
+    const auto size = file.size();
+    if (size == 0) {
+        *sequence = 0;
+        return entries;
+    }
+
+    if (const uchar *data = file.map(0, size)) {
+        const auto document = std::string_view{reinterpret_cast<const char *>(data), static_cast<size_t>(size)};
+        const bool streamed = read_accounts(document, entries, sequence);
+        file.unmap(const_cast<uchar *>(data));
 
-    auto *accounts_array = config.get_as<toml::array>("accounts");
-    if (!accounts_array || index < 0 || static_cast<size_t>(index) >= accounts_array->size()) { return false; }
+        if (streamed) return entries;
+    }
 
-    accounts_array->erase(accounts_array->begin() + index);
-    return save(config);
+    // anything the streaming reader does not understand goes through toml++, which also
+    // reports genuine syntax errors to the user
+    const auto config = load_shared();
+    *sequence = (*config)["journal_sequence"].value_or(std::int64_t{0});
+    return accounts_from_table(*config);
 }
 
 } // namespace core
@@ -8,34 +8,86 @@
 #include <QString>
 #include <QVector>
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+
 namespace core {
 
+class Account_Columns;
+class Account_Journal;
+struct Account_Fields;
+struct Journal_Record;
+
+/// @brief A persistent account identifier; 0 means "not assigned yet".
+using Account_Id = std::uint64_t;
+
 /// @struct Account
 /// @brief Represents a single user account with credentials and a note.
 struct Account {
+    /// @brief Stored in the file as "id"; stays the same across edits and reorders.
+    Account_Id id = 0;
+
     QString note;
     QString username;
     QString password;
 };
 
+/// @brief Generates a new random, non-zero account ID.
+/// @note IDs are kept within 63 bits so they round-trip through TOML's signed integers.
+auto generate_account_id() -> Account_Id;
+
+/// @brief Extracts every entry of the "accounts" array, in file order.
+/// @note Entries are returned even if incomplete, so that nothing is lost on rewrite.
+auto accounts_from_table(const toml::table &config) -> QVector<Account>;
+
+/// @brief Builds the TOML table of a single account.
+auto account_to_table(const Account &account) -> toml::table;
+
 /// @class Account_Config
 /// @brief Manages account-specific data in the configuration file.
+///
+/// Mutations are appended to an Account_Journal rather than rewriting the file;
+/// reads replay the journal on top of the TOML snapshot, which is itself read from
+/// its memory-mapped Binary_Snapshot mirror whenever that is up to date, and streamed
+/// with scan_accounts otherwise.
 class Account_Config final : public Config {
   public:
     /// @brief Constructs the account configuration manager.
     Account_Config();
 
-    /// @brief Returns a list of all accounts from the configuration file.
-    auto get_accounts() const -> QVector<Account>;
+    /// @brief Waits for any pending journal compaction.
+    ~Account_Config() override;
+
+    /// @brief Returns all accounts from the configuration file.
+    /// @note The fields are copied into the columns as UTF-8, without decoding them to QString.
+    /// Entries written before IDs existed are assigned one, and the file is rewritten once.
+    auto get_accounts() const -> Account_Columns;
+
+    /// @brief Adds a new account to the configuration file, assigning an ID if it has none.
+    auto add_account(Account account) -> bool;
+
+    /// @brief Updates the account with the given ID.
+    auto update_account(Account_Id id, const Account &account) -> bool;
+
+    /// @brief Removes the account with the given ID.
+    auto remove_account(Account_Id id) -> bool;
+
+    /// @brief Persists a batch of add/update/remove records with a single journal write.
+    auto commit(const QVector<Journal_Record> &records) -> bool;
 
-    /// @brief Adds a new account to the configuration file.
-    auto add_account(const Account &account) -> bool;
+  private:
+    /// @brief Reads the snapshot entries, preferring the binary mirror over parsing TOML.
+    /// @param on_account Receives every entry in file order as UTF-8 views; with an up to date
+    /// mirror they point straight into the mapping, so nothing is decoded or copied on the way.
+    /// @param sequence Receives the journal sequence folded into the snapshot.
+    auto load_entries(const std::function<void(const Account_Fields &)> &on_account, std::int64_t *sequence) const -> void;
 
-    /// @brief Updates an existing account at a specific index.
-    auto update_account(int index, const Account &account) -> bool;
+    /// @brief Reads the TOML file with the streaming reader, falling back to toml++.
+    auto read_entries(std::int64_t *sequence) const -> QVector<Account>;
 
-    /// @brief Removes an account at a specific index.
-    auto remove_account(int index) -> bool;
+  private:
+    std::unique_ptr<Account_Journal> journal_;
 };
 
 } // namespace core
@@ -0,0 +1,268 @@
+// =================================================================================
+// core/account_columns.cc
+// =================================================================================
+
+#include "account_columns.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace core {
+
+/// @brief Arenas smaller than this are never compacted; the dead bytes are not worth a copy.
+static constexpr qsizetype MIN_COMPACT_SIZE = 64 * 1024;
+
+/// @brief How many slices a substring scan steps over before switching to a binary search.
+static constexpr int LINEAR_PROBES = 8;
+
+auto Account_View::to_account() const -> Account
+{
+    Account account;
+    account.id = id;
+    account.note = note.toString();
+    account.username = username.toString();
+    account.password = password.toString();
+    return account;
+}
+
+Account_Columns::Account_Columns(const QVector<Account> &accounts)
+{
+    reserve(static_cast<int>(accounts.size()), 0);
+    for (const auto &account : accounts) append(account);
+}
+
+auto Account_Columns::size() const -> int
+{
+    return static_cast<int>(ids_.size());
+}
+
+auto Account_Columns::is_empty() const -> bool
+{
+    return ids_.isEmpty();
+}
+
+auto Account_Columns::id(int index) const -> Account_Id
+{
+    return ids_[index];
+}
+
+auto Account_Columns::field(int index, Field field) const -> QUtf8StringView
+{
+    const auto &col = column(field);
+    const auto slice = col.slices[index];
+    return QUtf8StringView{col.arena.constData() + slice.offset, static_cast<qsizetype>(slice.length)};
+}
+
+auto Account_Columns::at(int index) const -> Account_View
+{
+    return {
+        .id = ids_[index],
+        .note = field(index, Field::Note),
+        .username = field(index, Field::Username),
+        .password = field(index, Field::Password),
+    };
+}
+
+auto Account_Columns::ids() const -> const QVector<Account_Id> &
+{
+    return ids_;
+}
+
+auto Account_Columns::find(Field field, const Substring_Filter &filter) const -> QVector<int>
+{
+    const auto &col = column(field);
+
+    QVector<int> hits;
+    if (filter.size() == 0) {
+        hits.reserve(size());
+        for (int i = 0; i < size(); ++i) hits.append(i);
+        return hits;
+    }
+
+    if (!col.ordered) {
+        for (int i = 0; i < size(); ++i) {
+            if (filter.matches(this->field(i, field))) hits.append(i);
+        }
+        return hits;
+    }
+
+    const auto arena = std::string_view{col.arena.constData(), static_cast<std::size_t>(col.arena.size())};
+    const auto slice_end = [](const Slice &slice) { return static_cast<std::size_t>(slice.offset) + slice.length; };
+
+    std::size_t from = 0;
+    auto slice = col.slices.cbegin();
+    while (slice != col.slices.cend()) {
+        const auto hit = filter.find(arena, from);
+        if (hit == std::string_view::npos) break;
+
+        // the last slice starting at or before the hit is the only one that can contain it;
+        // dense hits are usually a few slices ahead, sparse ones are binary searched
+        for (int step = 0; slice != col.slices.cend() && slice->offset <= hit; ++step, ++slice) {
+            if (step < LINEAR_PROBES) continue;
+
+            slice = std::upper_bound(slice, col.slices.cend(), hit, [](std::size_t offset, const Slice &s) { return offset < s.offset; });
+            break;
+        }
+        if (slice == col.slices.cbegin()) {
+            from = hit + 1;
+            continue;
+        }
+
+        const auto owner = std::prev(slice);
+        if (hit + filter.size() <= slice_end(*owner)) {
+            // report every account once, then resume after the end of its field
+            hits.append(static_cast<int>(owner - col.slices.cbegin()));
+            from = slice_end(*owner);
+        } else {
+            // the hit straddles a field boundary or dead bytes
+            from = hit + 1;
+            slice = owner;
+        }
+    }
+
+    return hits;
+}
+
+auto Account_Columns::append(const Account &account) -> void
+{
+    ids_.append(account.id);
+    column(Field::Note).slices.append(column(Field::Note).store(account.note.toUtf8()));
+    column(Field::Username).slices.append(column(Field::Username).store(account.username.toUtf8()));
+    column(Field::Password).slices.append(column(Field::Password).store(account.password.toUtf8()));
+}
+
+auto Account_Columns::append(Account_Id id, QUtf8StringView note, QUtf8StringView username, QUtf8StringView password) -> void
+{
+    const auto bytes = [](QUtf8StringView value) { return QByteArrayView{reinterpret_cast<const char *>(value.data()), value.size()}; };
+
+    ids_.append(id);
+    column(Field::Note).slices.append(column(Field::Note).store(bytes(note)));
+    column(Field::Username).slices.append(column(Field::Username).store(bytes(username)));
+    column(Field::Password).slices.append(column(Field::Password).store(bytes(password)));
+}
+
+auto Account_Columns::replace(int index, const Account &account) -> void
+{
+    ids_[index] = account.id;
+
+    const bool is_last = index == size() - 1;
+    const auto replace_field = [index, is_last](Column &col, const QString &value) {
+        const auto slice = col.store(value.toUtf8());
+        col.ordered = col.ordered && is_last;
+        col.release(std::exchange(col.slices[index], slice));
+    };
+
+    replace_field(column(Field::Note), account.note);
+    replace_field(column(Field::Username), account.username);
+    replace_field(column(Field::Password), account.password);
+}
+
+auto Account_Columns::set_id(int index, Account_Id id) -> void
+{
+    ids_[index] = id;
+}
+
+auto Account_Columns::remove_at(int index) -> void
+{
+    ids_.removeAt(index);
+    for (auto &col : columns_) {
+        const auto slice = col.slices[index];
+        col.slices.removeAt(index);
+        col.release(slice);
+    }
+}
+
+auto Account_Columns::remove_marked(const QVector<bool> &marked) -> void
+{
+    qsizetype kept = 0;
+    for (qsizetype i = 0; i < ids_.size(); ++i) {
+        if (marked[i]) continue;
+        ids_[kept++] = ids_[i];
+    }
+    if (kept == ids_.size()) return;
+    ids_.resize(kept);
+
+    // dropping slices keeps the rest in arena order, so only the dead bytes change
+    for (auto &col : columns_) {
+        kept = 0;
+        for (qsizetype i = 0; i < col.slices.size(); ++i) {
+            if (marked[i]) {
+                col.dead_bytes += col.slices[i].length;
+                continue;
+            }
+            col.slices[kept++] = col.slices[i];
+        }
+        col.slices.resize(kept);
+        col.reclaim();
+    }
+}
+
+auto Account_Columns::reserve(int accounts, qsizetype bytes_per_field) -> void
+{
+    ids_.reserve(accounts);
+    for (auto &col : columns_) {
+        col.slices.reserve(accounts);
+        col.arena.reserve(bytes_per_field);
+    }
+}
+
+auto Account_Columns::memory_usage() const -> qsizetype
+{
+    auto bytes = ids_.capacity() * static_cast<qsizetype>(sizeof(Account_Id));
+    for (const auto &col : columns_) bytes += col.arena.capacity() + col.slices.capacity() * static_cast<qsizetype>(sizeof(Slice));
+    return bytes;
+}
+
+auto Account_Columns::to_accounts() const -> QVector<Account>
+{
+    QVector<Account> accounts;
+    accounts.reserve(size());
+    for (int i = 0; i < size(); ++i) accounts.append(at(i).to_account());
+    return accounts;
+}
+
+auto Account_Columns::column(Field field) -> Column &
+{
+    return columns_[static_cast<int>(field)];
+}
+
+auto Account_Columns::column(Field field) const -> const Column &
+{
+    return columns_[static_cast<int>(field)];
+}
+
+auto Account_Columns::Column::store(QByteArrayView utf8) -> Slice
+{
+    const auto slice = Slice{static_cast<std::uint32_t>(arena.size()), static_cast<std::uint32_t>(utf8.size())};
+    arena.append(utf8.data(), utf8.size());
+    return slice;
+}
+
+auto Account_Columns::Column::release(Slice slice) -> void
+{
+    dead_bytes += slice.length;
+    reclaim();
+}
+
+auto Account_Columns::Column::reclaim() -> void
+{
+    if (arena.size() >= MIN_COMPACT_SIZE && dead_bytes * 2 > arena.size()) compact();
+}
+
+auto Account_Columns::Column::compact() -> void
+{
+    QByteArray live;
+    live.reserve(arena.size() - dead_bytes);
+
+    for (auto &slice : slices) {
+        const auto offset = static_cast<std::uint32_t>(live.size());
+        live.append(arena.constData() + slice.offset, static_cast<qsizetype>(slice.length));
+        slice.offset = offset;
+    }
+
+    arena = std::move(live);
+    dead_bytes = 0;
+    ordered = true;
+}
+
+} // namespace core
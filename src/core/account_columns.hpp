@@ -0,0 +1,144 @@
+// =================================================================================
+// core/account_columns.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+#include "core/substring_filter.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QUtf8StringView>
+#include <QVector>
+
+#include <cstdint>
+
+namespace core {
+
+/// @struct Account_View
+/// @brief A lightweight, non-owning view of one account stored in Account_Columns.
+/// @note The views are invalidated by any mutation of the columns they came from.
+struct Account_View {
+    Account_Id id = 0;
+    QUtf8StringView note;
+    QUtf8StringView username;
+    QUtf8StringView password;
+
+    /// @brief Copies the viewed fields into an owning Account.
+    auto to_account() const -> Account;
+};
+
+/// @class Account_Columns
+/// @brief A struct-of-arrays container of accounts backed by UTF-8 string arenas.
+///
+/// Each field is kept in its own contiguous arena with an (offset, length) column
+/// next to it, and the IDs live in a plain column of their own. Storing N accounts
+/// costs a handful of allocations instead of 3N UTF-16 strings, and a scan over one
+/// field walks contiguous memory. Updated and removed strings leave dead bytes behind
+/// in the arenas, which are reclaimed once they outweigh the live ones.
+///
+/// @note Copies are cheap: the arenas and columns are implicitly shared until written to.
+class Account_Columns final {
+  public:
+    /// @brief The string fields, one arena each.
+    enum class Field : std::uint8_t { Note, Username, Password, Count };
+
+    Account_Columns() = default;
+
+    /// @brief Builds the columns from a list of accounts, preserving their order.
+    explicit Account_Columns(const QVector<Account> &accounts);
+
+    /// @brief Returns the number of accounts.
+    auto size() const -> int;
+
+    /// @brief Returns true if there are no accounts.
+    auto is_empty() const -> bool;
+
+    /// @brief Returns the ID of the account at a given position.
+    auto id(int index) const -> Account_Id;
+
+    /// @brief Returns one field of the account at a given position, pointing into its arena.
+    auto field(int index, Field field) const -> QUtf8StringView;
+
+    /// @brief Returns a view of the account at a given position.
+    auto at(int index) const -> Account_View;
+
+    /// @brief Returns every ID in order, e.g. to build a lookup index.
+    auto ids() const -> const QVector<Account_Id> &;
+
+    /// @brief Returns the positions of the accounts whose field contains a substring, in ascending order.
+    ///
+    /// While the slices of a field are laid out in arena order, which holds unless an
+    /// account other than the last was replaced since the last compaction, the whole
+    /// arena is scanned in one pass and hits are mapped back to accounts.
+    auto find(Field field, const Substring_Filter &filter) const -> QVector<int>;
+
+    /// @brief Appends an account to the end of the columns.
+    auto append(const Account &account) -> void;
+
+    /// @brief Appends an account from UTF-8 fields, copying the bytes straight into the arenas.
+    auto append(Account_Id id, QUtf8StringView note, QUtf8StringView username, QUtf8StringView password) -> void;
+
+    /// @brief Replaces the fields of the account at a given position, including its ID.
+    auto replace(int index, const Account &account) -> void;
+
+    /// @brief Changes only the ID of the account at a given position.
+    auto set_id(int index, Account_Id id) -> void;
+
+    /// @brief Removes the account at a given position; the accounts after it move up by one.
+    auto remove_at(int index) -> void;
+
+    /// @brief Removes every account whose flag is set in a single pass, keeping the others in order.
+    /// @param marked One flag per account.
+    auto remove_marked(const QVector<bool> &marked) -> void;
+
+    /// @brief Reserves room for a number of accounts and string bytes per field.
+    auto reserve(int accounts, qsizetype bytes_per_field) -> void;
+
+    /// @brief Returns the number of bytes allocated by the arenas and columns.
+    auto memory_usage() const -> qsizetype;
+
+    /// @brief Decodes every account into owning Account values.
+    auto to_accounts() const -> QVector<Account>;
+
+  private:
+    /// @brief The location of one string inside its arena.
+    struct Slice {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    /// @brief One field of every account: the arena and the slice of each account in it.
+    struct Column {
+        QByteArray arena;
+        QVector<Slice> slices;
+
+        /// @brief The number of arena bytes no longer referenced by any slice.
+        qsizetype dead_bytes = 0;
+
+        /// @brief True while every slice starts after the end of the slice before it.
+        bool ordered = true;
+
+        /// @brief Copies a UTF-8 string to the end of the arena and returns its slice.
+        auto store(QByteArrayView utf8) -> Slice;
+
+        /// @brief Marks a slice's bytes as unreferenced, compacting the arena if it is mostly dead.
+        auto release(Slice slice) -> void;
+
+        /// @brief Compacts the arena once its dead bytes outweigh the live ones.
+        auto reclaim() -> void;
+
+        /// @brief Rewrites the arena so that it only holds referenced bytes, in slice order.
+        auto compact() -> void;
+    };
+
+    auto column(Field field) -> Column &;
+    auto column(Field field) const -> const Column &;
+
+  private:
+    QVector<Account_Id> ids_;
+    Column columns_[static_cast<int>(Field::Count)];
+};
+
+} // namespace core
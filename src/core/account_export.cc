@@ -0,0 +1,197 @@
+// =================================================================================
+// core/account_export.cc
+// =================================================================================
+
+#include "account_export.hpp"
+
+#include <QSaveFile>
+
+#include <charconv>
+#include <string>
+
+using namespace std::literals;
+
+namespace core {
+
+namespace {
+
+/// @brief The output is written whenever the buffer grows past this size.
+constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+using Field = Account_Columns::Field;
+
+/// @brief Collects encoded records and writes them to the file in fixed-size chunks.
+class Chunked_Writer final {
+  public:
+    explicit Chunked_Writer(QSaveFile &file)
+        : file_{file}
+    {
+        buffer_.reserve(BUFFER_SIZE + BUFFER_SIZE / 4);
+    }
+
+    auto buffer() -> std::string &
+    {
+        return buffer_;
+    }
+
+    /// @brief Writes the buffer out once it is full; call after every record.
+    auto record_done() -> void
+    {
+        if (buffer_.size() >= BUFFER_SIZE) write_buffer();
+    }
+
+    /// @brief Writes the rest of the buffer and commits the file.
+    auto finish() -> bool
+    {
+        write_buffer();
+        return ok_ && file_.commit();
+    }
+
+  private:
+    auto write_buffer() -> void
+    {
+        if (buffer_.empty()) return;
+
+        const auto size = static_cast<qint64>(buffer_.size());
+        ok_ = ok_ && file_.write(buffer_.data(), size) == size;
+        buffer_.clear();
+    }
+
+  private:
+    QSaveFile &file_;
+    std::string buffer_;
+    bool ok_ = true;
+};
+
+auto to_string_view(QUtf8StringView value) -> std::string_view
+{
+    return std::string_view{reinterpret_cast<const char *>(value.data()), static_cast<std::size_t>(value.size())};
+}
+
+/// @brief Appends a double-quoted string with JSON/TOML basic string escapes.
+auto append_quoted(std::string &out, std::string_view value) -> void
+{
+    constexpr auto hex = "0123456789ABCDEF"sv;
+
+    out.push_back('"');
+    for (const char c : value) {
+        switch (c) {
+        case '"': out.append("\\\""sv); break;
+        case '\\': out.append("\\\\"sv); break;
+        case '\b': out.append("\\b"sv); break;
+        case '\f': out.append("\\f"sv); break;
+        case '\n': out.append("\\n"sv); break;
+        case '\r': out.append("\\r"sv); break;
+        case '\t': out.append("\\t"sv); break;
+        default:
+            // TOML also forbids a raw DEL, JSON does not mind it escaped
+            if (static_cast<unsigned char>(c) < 0x20 || c == 0x7F) {
+                out.append("\\u00"sv);
+                out.push_back(hex[static_cast<unsigned char>(c) >> 4]);
+                out.push_back(hex[static_cast<unsigned char>(c) & 0xF]);
+            } else {
+                out.push_back(c);
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+/// @brief Appends an RFC 4180 field, quoted only if it has to be.
+auto append_csv_field(std::string &out, std::string_view value) -> void
+{
+    if (value.find_first_of(",\"\r\n"sv) == std::string_view::npos) {
+        out.append(value);
+        return;
+    }
+
+    out.push_back('"');
+    for (const char c : value) {
+        if (c == '"') out.push_back('"');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+auto append_integer(std::string &out, std::uint64_t value) -> void
+{
+    char digits[20];
+    const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+    out.append(digits, result.ptr);
+}
+
+auto write_csv(const Account_Columns &accounts, Chunked_Writer &writer) -> void
+{
+    auto &out = writer.buffer();
+    out.append("note,username,password\r\n"sv);
+
+    for (int i = 0; i < accounts.size(); ++i) {
+        append_csv_field(out, to_string_view(accounts.field(i, Field::Note)));
+        out.push_back(',');
+        append_csv_field(out, to_string_view(accounts.field(i, Field::Username)));
+        out.push_back(',');
+        append_csv_field(out, to_string_view(accounts.field(i, Field::Password)));
+        out.append("\r\n"sv);
+        writer.record_done();
+    }
+}
+
+auto write_json(const Account_Columns &accounts, Chunked_Writer &writer) -> void
+{
+    auto &out = writer.buffer();
+    out.push_back('[');
+
+    for (int i = 0; i < accounts.size(); ++i) {
+        out.append(i == 0 ? "\n  {\"note\": "sv : ",\n  {\"note\": "sv);
+        append_quoted(out, to_string_view(accounts.field(i, Field::Note)));
+        out.append(", \"username\": "sv);
+        append_quoted(out, to_string_view(accounts.field(i, Field::Username)));
+        out.append(", \"password\": "sv);
+        append_quoted(out, to_string_view(accounts.field(i, Field::Password)));
+        out.push_back('}');
+        writer.record_done();
+    }
+
+    out.append(accounts.is_empty() ? "]\n"sv : "\n]\n"sv);
+}
+
+auto write_toml(const Account_Columns &accounts, Chunked_Writer &writer) -> void
+{
+    auto &out = writer.buffer();
+
+    for (int i = 0; i < accounts.size(); ++i) {
+        out.append(i == 0 ? "[[accounts]]\nid = "sv : "\n[[accounts]]\nid = "sv);
+        append_integer(out, accounts.id(i));
+        out.append("\nnote = "sv);
+        append_quoted(out, to_string_view(accounts.field(i, Field::Note)));
+        out.append("\npassword = "sv);
+        append_quoted(out, to_string_view(accounts.field(i, Field::Password)));
+        out.append("\nusername = "sv);
+        append_quoted(out, to_string_view(accounts.field(i, Field::Username)));
+        out.push_back('\n');
+        writer.record_done();
+    }
+}
+
+} // namespace
+
+auto export_accounts(const Account_Columns &accounts, const QString &path) -> Export_Result<int>
+{
+    const auto format = import_format_of(path);
+    if (!format) return std::unexpected(Export_Error::Unsupported_Format);
+
+    auto file = QSaveFile{path};
+    if (!file.open(QIODevice::WriteOnly)) return std::unexpected(Export_Error::Open_Failed);
+
+    auto writer = Chunked_Writer{file};
+    switch (*format) {
+    case Import_Format::Csv: write_csv(accounts, writer); break;
+    case Import_Format::Json: write_json(accounts, writer); break;
+    case Import_Format::Toml: write_toml(accounts, writer); break;
+    }
+
+    if (!writer.finish()) return std::unexpected(Export_Error::Write_Failed);
+    return accounts.size();
+}
+
+} // namespace core
@@ -0,0 +1,53 @@
+// =================================================================================
+// core/account_export.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account_columns.hpp"
+#include "core/account_import.hpp"
+
+#include <QString>
+
+#include <expected>
+#include <string_view>
+
+namespace core {
+
+/// @brief Defines error codes for account exports.
+enum class Export_Error {
+    None,
+    Unsupported_Format,
+    Open_Failed,
+    Write_Failed,
+};
+
+/// @brief Converts an Export_Error enum to a user-readable string.
+constexpr inline auto export_error_as_string(Export_Error error) -> std::string_view
+{
+    using E = Export_Error;
+    using namespace std::string_view_literals;
+
+    switch (error) {
+    case E::Unsupported_Format: return "The file type is not supported. Use a .csv, .json or .toml file."sv;
+    case E::Open_Failed: return "The file could not be created."sv;
+    case E::Write_Failed: return "The accounts could not be written to the file."sv;
+    case E::None: return "No error."sv;
+    default: return "An unknown export error occurred."sv;
+    }
+}
+
+/// @brief A result type for exports that can return a value or an error.
+template <typename T> using Export_Result = std::expected<T, Export_Error>;
+
+/// @brief Streams every account to a CSV, JSON or TOML file, picked by its extension.
+///
+/// Records are encoded straight from the column views into a fixed-size buffer that
+/// is written out whenever it fills up, so memory use does not grow with the number
+/// of accounts. The output is readable by parse_import_file; the TOML flavor is the
+/// accounts.toml layout, IDs included. The file is replaced atomically.
+///
+/// @return The number of accounts written.
+auto export_accounts(const Account_Columns &accounts, const QString &path) -> Export_Result<int>;
+
+} // namespace core
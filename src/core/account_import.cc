@@ -0,0 +1,437 @@
+// =================================================================================
+// core/account_import.cc
+// =================================================================================
+
+#include "account_import.hpp"
+#include "account_reader.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using namespace std::literals;
+
+namespace core {
+
+namespace {
+
+/// @brief Chunks smaller than this are not worth handing to a thread of their own.
+constexpr std::size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+/// @brief How many chunks each thread gets, so that uneven chunks still balance out.
+constexpr int CHUNKS_PER_THREAD = 4;
+
+constexpr auto NPOS = std::string_view::npos;
+
+/// @brief Parses one chunk of a document, appending its accounts in order.
+using Chunk_Parser = std::function<bool(std::string_view chunk, QVector<Account> &accounts)>;
+
+auto to_qstring(std::string_view utf8) -> QString
+{
+    return QString::fromUtf8(utf8.data(), static_cast<qsizetype>(utf8.size()));
+}
+
+auto chunk_size_for(std::string_view document) -> std::size_t
+{
+    const auto chunk_count = static_cast<std::size_t>(std::max(1, QThread::idealThreadCount()) * CHUNKS_PER_THREAD);
+    return std::max(MIN_CHUNK_SIZE, document.size() / chunk_count + 1);
+}
+
+/// @brief Runs the parser on every chunk on a thread pool and joins the results in order.
+auto parse_in_parallel(const QVector<std::string_view> &chunks, const Import_Progress &progress, const Chunk_Parser &parse_chunk)
+    -> Import_Result<QVector<Account>>
+{
+    std::int64_t total = 0;
+    for (const auto &chunk : chunks) total += static_cast<std::int64_t>(chunk.size());
+
+    QVector<QVector<Account>> results(chunks.size());
+    std::atomic<bool> failed = false;
+    std::atomic<std::int64_t> done = 0;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+
+    for (qsizetype i = 0; i < chunks.size(); ++i) {
+        pool.start([&, i] {
+            if (failed) return;
+            if (!parse_chunk(chunks[i], results[i])) {
+                failed = true;
+                return;
+            }
+
+            const auto parsed = done += static_cast<std::int64_t>(chunks[i].size());
+            if (progress) progress(parsed, total);
+        });
+    }
+    pool.waitForDone();
+
+    if (failed) return std::unexpected(Import_Error::Parse_Failed);
+
+    QVector<Account> accounts;
+    qsizetype count = 0;
+    for (const auto &result : results) count += result.size();
+
+    accounts.reserve(count);
+    for (auto &result : results) {
+        for (auto &account : result) accounts.append(std::move(account));
+    }
+    return accounts;
+}
+
+//
+// CSV
+//
+
+/// @brief The column of each account field; -1 if the file has no such column.
+struct Csv_Columns {
+    int note = 2;
+    int username = 0;
+    int password = 1;
+};
+
+/// @brief Reads one RFC 4180 record and leaves pos at the start of the next one.
+/// @param scratch Holds the fields that needed unescaping; a deque so that views into it stay valid.
+/// @return False on an unterminated quote or text after a closing quote.
+auto read_csv_record(std::string_view text, std::size_t &pos, std::vector<std::string_view> &fields, std::deque<std::string> &scratch)
+    -> bool
+{
+    fields.clear();
+
+    while (true) {
+        if (pos < text.size() && text[pos] == '"') {
+            const std::size_t begin = ++pos;
+            bool escaped = false;
+
+            while (true) {
+                const auto quote = text.find('"', pos);
+                if (quote == NPOS) return false;
+
+                if (quote + 1 < text.size() && text[quote + 1] == '"') {
+                    escaped = true;
+                    pos = quote + 2;
+                    continue;
+                }
+
+                pos = quote + 1;
+                const auto raw = text.substr(begin, quote - begin);
+                if (!escaped) {
+                    fields.push_back(raw);
+                    break;
+                }
+
+                if (scratch.size() <= fields.size()) scratch.resize(fields.size() + 1);
+                auto &unescaped = scratch[fields.size()];
+                unescaped.clear();
+                for (std::size_t i = 0; i < raw.size(); ++i) {
+                    unescaped.push_back(raw[i]);
+                    if (raw[i] == '"') ++i;
+                }
+                fields.push_back(unescaped);
+                break;
+            }
+        } else {
+            const auto end = std::min(text.find_first_of(",\r\n"sv, pos), text.size());
+            fields.push_back(text.substr(pos, end - pos));
+            pos = end;
+        }
+
+        if (pos == text.size()) return true;
+        if (text[pos] == ',') {
+            ++pos;
+            continue;
+        }
+
+        if (text[pos] == '\r') ++pos;
+        if (pos == text.size()) return true;
+        if (text[pos] != '\n') return false;
+
+        ++pos;
+        return true;
+    }
+}
+
+/// @brief Detects a header row and maps its columns.
+/// @param body_start Receives the offset of the first data record.
+auto read_csv_header(std::string_view document, std::size_t *body_start) -> std::optional<Csv_Columns>
+{
+    std::size_t pos = 0;
+    std::vector<std::string_view> fields;
+    std::deque<std::string> scratch;
+    if (!read_csv_record(document, pos, fields, scratch)) return std::nullopt;
+
+    auto columns = Csv_Columns{.note = -1, .username = -1, .password = -1};
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        const auto name = to_qstring(fields[i]).trimmed().toLower();
+        if (name == "note") columns.note = static_cast<int>(i);
+        if (name == "username") columns.username = static_cast<int>(i);
+        if (name == "password") columns.password = static_cast<int>(i);
+    }
+
+    // no header, the first row is already an account
+    if (columns.username < 0) {
+        *body_start = 0;
+        return Csv_Columns{};
+    }
+
+    if (columns.password < 0) return std::nullopt;
+
+    *body_start = pos;
+    return columns;
+}
+
+/// @brief Splits CSV records into chunks, never cutting inside a quoted field.
+auto split_csv(std::string_view body) -> QVector<std::string_view>
+{
+    const auto chunk_size = chunk_size_for(body);
+
+    QVector<std::string_view> chunks;
+    std::size_t start = 0;
+    bool quoted = false;
+
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        if (body[i] == '"') {
+            quoted = !quoted;
+        } else if (body[i] == '\n' && !quoted && i + 1 - start >= chunk_size) {
+            chunks.append(body.substr(start, i + 1 - start));
+            start = i + 1;
+        }
+    }
+
+    if (start < body.size()) chunks.append(body.substr(start));
+    return chunks;
+}
+
+auto parse_csv_chunk(std::string_view chunk, const Csv_Columns &columns, QVector<Account> &accounts) -> bool
+{
+    std::vector<std::string_view> fields;
+    std::deque<std::string> scratch;
+
+    const auto field_at = [&fields](int column) {
+        return column >= 0 && static_cast<std::size_t>(column) < fields.size() ? to_qstring(fields[column]) : QString{};
+    };
+
+    std::size_t pos = 0;
+    while (pos < chunk.size()) {
+        if (!read_csv_record(chunk, pos, fields, scratch)) return false;
+        if (fields.size() == 1 && fields.front().empty()) continue;
+
+        Account account;
+        account.note = field_at(columns.note);
+        account.username = field_at(columns.username);
+        account.password = field_at(columns.password);
+        accounts.append(std::move(account));
+    }
+
+    return true;
+}
+
+auto parse_csv(std::string_view document, const Import_Progress &progress) -> Import_Result<QVector<Account>>
+{
+    std::size_t body_start = 0;
+    const auto columns = read_csv_header(document, &body_start);
+    if (!columns) return std::unexpected(Import_Error::Parse_Failed);
+
+    const auto parse_chunk = [&columns](std::string_view chunk, QVector<Account> &accounts) {
+        return parse_csv_chunk(chunk, *columns, accounts);
+    };
+    return parse_in_parallel(split_csv(document.substr(body_start)), progress, parse_chunk);
+}
+
+//
+// JSON
+//
+
+auto string_field(const json &object, const char *key) -> QString
+{
+    const auto it = object.find(key);
+    if (it == object.end() || !it->is_string()) return {};
+    return QString::fromStdString(it->get_ref<const std::string &>());
+}
+
+auto accounts_from_json(const json &array, QVector<Account> &accounts) -> bool
+{
+    if (!array.is_array()) return false;
+
+    for (const auto &entry : array) {
+        if (!entry.is_object()) return false;
+
+        Account account;
+        account.note = string_field(entry, "note");
+        account.username = string_field(entry, "username");
+        account.password = string_field(entry, "password");
+        accounts.append(std::move(account));
+    }
+
+    return true;
+}
+
+/// @brief Splits the elements of a top-level JSON array into chunks of whole elements.
+/// @return Nothing if the document is not a well-nested array.
+auto split_json_array(std::string_view document) -> std::optional<QVector<std::string_view>>
+{
+    const auto open = document.find_first_not_of(" \t\r\n"sv);
+    if (open == NPOS || document[open] != '[') return std::nullopt;
+
+    const auto chunk_size = chunk_size_for(document);
+
+    QVector<std::string_view> chunks;
+    std::size_t start = open + 1;
+    int depth = 0;
+    bool in_string = false;
+
+    for (std::size_t i = open + 1; i < document.size(); ++i) {
+        const char c = document[i];
+        if (in_string) {
+            if (c == '\\') {
+                ++i;
+            } else if (c == '"') {
+                in_string = false;
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"': in_string = true; break;
+        case '{':
+        case '[': ++depth; break;
+        case '}':
+        case ']':
+            if (depth > 0) {
+                --depth;
+                break;
+            }
+
+            if (c != ']') return std::nullopt;
+            if (document.substr(start, i - start).find_first_not_of(" \t\r\n"sv) != NPOS) chunks.append(document.substr(start, i - start));
+            return chunks;
+        case ',':
+            if (depth == 0 && i - start >= chunk_size) {
+                chunks.append(document.substr(start, i - start));
+                start = i + 1;
+            }
+            break;
+        default: break;
+        }
+    }
+
+    return std::nullopt;
+}
+
+auto parse_json(std::string_view document, const Import_Progress &progress) -> Import_Result<QVector<Account>>
+{
+    if (const auto chunks = split_json_array(document)) {
+        return parse_in_parallel(*chunks, progress, [](std::string_view chunk, QVector<Account> &accounts) {
+            auto array = std::string{};
+            array.reserve(chunk.size() + 2);
+            array.append("[").append(chunk).append("]");
+
+            const auto data = json::parse(array, nullptr, false);
+            return !data.is_discarded() && accounts_from_json(data, accounts);
+        });
+    }
+
+    // objects wrapping the array cannot be split up front, so they are parsed in one go
+    const auto data = json::parse(document, nullptr, false);
+    if (data.is_discarded() || !data.is_object() || !data.contains("accounts")) return std::unexpected(Import_Error::Parse_Failed);
+
+    QVector<Account> accounts;
+    if (!accounts_from_json(data["accounts"], accounts)) return std::unexpected(Import_Error::Parse_Failed);
+
+    if (progress) progress(static_cast<std::int64_t>(document.size()), static_cast<std::int64_t>(document.size()));
+    return accounts;
+}
+
+//
+// TOML
+//
+
+/// @brief Splits a TOML document in front of "[[" header lines, so that every chunk
+/// after the first is a run of whole [[accounts]] tables.
+auto split_toml(std::string_view document) -> QVector<std::string_view>
+{
+    const auto chunk_size = chunk_size_for(document);
+
+    QVector<std::string_view> chunks;
+    std::size_t start = 0;
+    std::size_t line = 0;
+
+    while (line < document.size()) {
+        if (line - start >= chunk_size && document.substr(line, 2) == "[["sv) {
+            chunks.append(document.substr(start, line - start));
+            start = line;
+        }
+
+        const auto newline = document.find('\n', line);
+        if (newline == NPOS) break;
+        line = newline + 1;
+    }
+
+    chunks.append(document.substr(start));
+    return chunks;
+}
+
+auto parse_toml(std::string_view document, const Import_Progress &progress) -> Import_Result<QVector<Account>>
+{
+    // a cut inside a multi-line string makes a chunk fail, which falls through to toml++
+    auto accounts = parse_in_parallel(split_toml(document), progress, [](std::string_view chunk, QVector<Account> &chunk_accounts) {
+        std::int64_t sequence = 0;
+        return read_accounts(chunk, chunk_accounts, &sequence);
+    });
+    if (accounts) return accounts;
+
+    const auto result = toml::parse(document);
+    if (!result) return std::unexpected(Import_Error::Parse_Failed);
+
+    if (progress) progress(static_cast<std::int64_t>(document.size()), static_cast<std::int64_t>(document.size()));
+    return accounts_from_table(result.table());
+}
+
+} // namespace
+
+auto import_format_of(const QString &path) -> std::optional<Import_Format>
+{
+    const auto suffix = QFileInfo{path}.suffix().toLower();
+    if (suffix == "csv") return Import_Format::Csv;
+    if (suffix == "json") return Import_Format::Json;
+    if (suffix == "toml") return Import_Format::Toml;
+    return std::nullopt;
+}
+
+auto parse_import_file(const QString &path, const Import_Progress &progress) -> Import_Result<QVector<Account>>
+{
+    const auto format = import_format_of(path);
+    if (!format) return std::unexpected(Import_Error::Unsupported_Format);
+
+    auto file = QFile{path};
+    if (!file.open(QIODevice::ReadOnly)) return std::unexpected(Import_Error::Open_Failed);
+
+    const auto size = file.size();
+    if (size == 0) return QVector<Account>{};
+
+    const uchar *data = file.map(0, size);
+    if (!data) return std::unexpected(Import_Error::Open_Failed);
+
+    auto document = std::string_view{reinterpret_cast<const char *>(data), static_cast<std::size_t>(size)};
+    if (document.starts_with("\xEF\xBB\xBF"sv)) document.remove_prefix(3);
+
+    Import_Result<QVector<Account>> accounts;
+    switch (*format) {
+    case Import_Format::Csv: accounts = parse_csv(document, progress); break;
+    case Import_Format::Json: accounts = parse_json(document, progress); break;
+    case Import_Format::Toml: accounts = parse_toml(document, progress); break;
+    }
+
+    file.unmap(const_cast<uchar *>(data));
+    return accounts;
+}
+
+} // namespace core
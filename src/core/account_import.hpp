@@ -0,0 +1,68 @@
+// =================================================================================
+// core/account_import.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace core {
+
+/// @brief The file formats accounts can be imported from.
+enum class Import_Format { Csv, Json, Toml };
+
+/// @brief Defines error codes for account imports.
+enum class Import_Error {
+    None,
+    Unsupported_Format,
+    Open_Failed,
+    Parse_Failed,
+};
+
+/// @brief Converts an Import_Error enum to a user-readable string.
+constexpr inline auto import_error_as_string(Import_Error error) -> std::string_view
+{
+    using E = Import_Error;
+    using namespace std::string_view_literals;
+
+    switch (error) {
+    case E::Unsupported_Format: return "The file type is not supported. Use a .csv, .json or .toml file."sv;
+    case E::Open_Failed: return "The file could not be opened."sv;
+    case E::Parse_Failed: return "The file could not be parsed."sv;
+    case E::None: return "No error."sv;
+    default: return "An unknown import error occurred."sv;
+    }
+}
+
+/// @brief A result type for imports that can return a value or an error.
+template <typename T> using Import_Result = std::expected<T, Import_Error>;
+
+/// @brief Receives the number of bytes parsed so far and the total; may be called from any thread.
+using Import_Progress = std::function<void(std::int64_t done, std::int64_t total)>;
+
+/// @brief Picks the import format from a file's extension.
+auto import_format_of(const QString &path) -> std::optional<Import_Format>;
+
+/// @brief Reads every account out of a CSV, JSON or TOML file, parsing chunks of it in parallel.
+///
+/// - CSV: RFC 4180 records. A header row naming "note", "username" and "password"
+///   columns in any order is honored; without one the columns are username, password
+///   and an optional note.
+/// - JSON: an array of objects with "note", "username" and "password" strings, or an
+///   object holding such an array under "accounts".
+/// - TOML: the [[accounts]] layout of accounts.toml.
+///
+/// The accounts are returned in file order without IDs; entries are not validated or
+/// deduplicated here.
+auto parse_import_file(const QString &path, const Import_Progress &progress) -> Import_Result<QVector<Account>>;
+
+} // namespace core
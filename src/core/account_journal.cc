@@ -0,0 +1,480 @@
+// =================================================================================
+// core/account_journal.cc
+// =================================================================================
+
+#include "account_journal.hpp"
+#include "binary_snapshot.hpp"
+#include "toml_patch.hpp"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+using json = nlohmann::json;
+using namespace std::literals;
+
+namespace core {
+
+/// @brief Number of live records after which the journal is folded into the snapshot.
+static constexpr int COMPACTION_THRESHOLD = 512;
+
+static constexpr auto SEQUENCE_KEY = "journal_sequence"sv;
+
+static auto op_as_string(Journal_Op op) -> std::string_view
+{
+    switch (op) {
+    case Journal_Op::Add: return "add"sv;
+    case Journal_Op::Update: return "update"sv;
+    case Journal_Op::Remove: return "remove"sv;
+    }
+    return "add"sv;
+}
+
+static auto op_from_string(std::string_view op) -> std::optional<Journal_Op>
+{
+    if (op == "add"sv) return Journal_Op::Add;
+    if (op == "update"sv) return Journal_Op::Update;
+    if (op == "remove"sv) return Journal_Op::Remove;
+    return std::nullopt;
+}
+
+/// @brief Maps every account ID to its first position; entries without a valid ID are left out.
+template <typename Id_Of> static auto index_by_id(qsizetype count, Id_Of id_of) -> QHash<Account_Id, qsizetype>
+{
+    QHash<Account_Id, qsizetype> positions;
+    positions.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        // the first of two duplicates wins, as a front-to-back search would find it
+        if (const auto id = id_of(i); id != 0 && !positions.contains(id)) positions.insert(id, i);
+    }
+    return positions;
+}
+
+/// @brief Reads "journal_sequence" from the snapshot without parsing the whole file.
+/// @note toml++ writes plain key/value pairs before any [[accounts]] table, so only
+/// the leading lines need to be scanned.
+static auto read_snapshot_sequence(const QString &path) -> std::int64_t
+{
+    auto file = QFile{path};
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return 0;
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.startsWith('[')) break;
+        if (!line.startsWith(SEQUENCE_KEY.data())) continue;
+
+        const auto equals = line.indexOf('=');
+        if (equals == -1) continue;
+
+        bool ok = false;
+        const auto sequence = line.mid(equals + 1).trimmed().toLongLong(&ok);
+        return ok ? sequence : 0;
+    }
+
+    return 0;
+}
+
+/// @brief Rewrites only the changed values when a batch consists purely of updates.
+/// @return The patched document, or nothing if the snapshot has to be re-serialized.
+static auto patch_updates(std::string_view document, const toml::table &snapshot, const QVector<Journal_Record> &records,
+                          std::int64_t sequence) -> std::optional<std::string>
+{
+    if (document.empty()) return std::nullopt;
+
+    // only the final state of each account matters, and it keeps the edits from overlapping
+    std::map<Account_Id, const Account *> updates;
+    for (const auto &record : records) {
+        if (record.op != Journal_Op::Update) return std::nullopt;
+        updates[record.account.id] = &record.account;
+    }
+
+    const auto *accounts_array = snapshot.get_as<toml::array>("accounts");
+    if (!accounts_array && !updates.empty()) return std::nullopt;
+
+    std::map<Account_Id, const toml::table *> tables;
+    if (accounts_array) {
+        for (const auto &node : *accounts_array) {
+            const auto *table = node.as_table();
+            // the first of two duplicates wins, matching apply() and so the binary mirror
+            if (table) tables.try_emplace(static_cast<Account_Id>((*table)["id"].value_or(std::int64_t{0})), table);
+        }
+    }
+
+    auto patch = Toml_Patch{document};
+    for (const auto &[id, account] : updates) {
+        const auto it = tables.find(id);
+        if (it == tables.end()) continue;
+        const auto *table = it->second;
+
+        const auto patch_field = [&](std::string_view key, const QString &value) {
+            const auto *node = table->get(key);
+            return node && node->is_string() && patch.replace(*node, value.toStdString());
+        };
+
+        if (!patch_field("note", account->note) || !patch_field("username", account->username) ||
+            !patch_field("password", account->password)) {
+            return std::nullopt;
+        }
+    }
+
+    if (const auto *node = snapshot.get(SEQUENCE_KEY)) {
+        if (!node->is_integer() || !patch.replace(*node, sequence)) return std::nullopt;
+    } else {
+        const auto bom = document.starts_with("\xEF\xBB\xBF"sv) ? std::size_t{3} : std::size_t{0};
+        patch.insert(bom, std::string{SEQUENCE_KEY} + " = " + std::to_string(sequence) + "\n");
+    }
+
+    return patch.apply();
+}
+
+Account_Journal::Account_Journal(const QString &snapshot_path)
+    : snapshot_path_{snapshot_path}
+{
+    const auto info = QFileInfo{snapshot_path};
+    journal_path_ = info.absolutePath() + "/" + info.completeBaseName() + ".journal";
+    compacting_path_ = journal_path_ + ".compacting";
+
+    compaction_pool_.setMaxThreadCount(1);
+
+    std::int64_t last_sequence = read_snapshot_sequence(snapshot_path_);
+    for (const auto &path : {compacting_path_, journal_path_}) {
+        for (const auto &record : read_records(path)) last_sequence = std::max(last_sequence, record.sequence);
+    }
+
+    next_sequence_ = last_sequence + 1;
+    record_count_ = static_cast<int>(read_records(journal_path_).size());
+    open_journal();
+
+    // a leftover rotated journal means the last compaction never finished
+    if (QFile::exists(compacting_path_)) request_compaction();
+}
+
+Account_Journal::~Account_Journal()
+{
+    compaction_pool_.waitForDone();
+    journal_file_.close();
+}
+
+auto Account_Journal::append(Journal_Record record) -> bool
+{
+    return append(QVector<Journal_Record>{std::move(record)});
+}
+
+auto Account_Journal::append(QVector<Journal_Record> records) -> bool
+{
+    if (records.isEmpty()) return true;
+
+    bool needs_compaction = false;
+    {
+        const auto lock = std::scoped_lock{mutex_};
+        if (!journal_file_.isOpen() && !open_journal()) return false;
+
+        auto sequence = next_sequence_;
+        auto bytes = std::string{};
+        for (auto &record : records) {
+            record.sequence = sequence++;
+
+            auto line = json{{"seq", record.sequence}, {"op", op_as_string(record.op)}, {"id", record.account.id}};
+            if (record.op != Journal_Op::Remove) {
+                line["note"] = record.account.note.toStdString();
+                line["username"] = record.account.username.toStdString();
+                line["password"] = record.account.password.toStdString();
+            }
+
+            bytes += line.dump();
+            bytes += '\n';
+        }
+
+        const auto size = static_cast<qint64>(bytes.size());
+        if (journal_file_.write(bytes.data(), size) != size || !journal_file_.flush()) return false;
+
+        next_sequence_ = sequence;
+        record_count_ += static_cast<int>(records.size());
+        needs_compaction = record_count_ >= COMPACTION_THRESHOLD;
+    }
+
+    if (needs_compaction) request_compaction();
+    return true;
+}
+
+auto Account_Journal::replay(const std::function<Account_Columns(std::int64_t *sequence)> &load_snapshot) const -> Account_Columns
+{
+    const auto lock = std::scoped_lock{mutex_};
+
+    std::int64_t snapshot_sequence = 0;
+    auto entries = load_snapshot(&snapshot_sequence);
+
+    QVector<Journal_Record> pending;
+    for (const auto &path : {compacting_path_, journal_path_}) {
+        for (auto &record : read_records(path)) {
+            if (record.sequence > snapshot_sequence) pending.append(std::move(record));
+        }
+    }
+
+    apply(entries, pending);
+    return entries;
+}
+
+auto Account_Journal::request_compaction() -> void
+{
+    {
+        const auto lock = std::scoped_lock{mutex_};
+        if (compaction_scheduled_) return;
+
+        // rotate the live journal so appends can continue while the fold runs
+        if (!QFile::exists(compacting_path_)) {
+            if (record_count_ == 0) return;
+
+            journal_file_.close();
+            if (!QFile::rename(journal_path_, compacting_path_)) {
+                open_journal();
+                return;
+            }
+
+            record_count_ = 0;
+            open_journal();
+        }
+
+        compaction_scheduled_ = true;
+    }
+
+    compaction_pool_.start([this] { compact(); });
+}
+
+auto Account_Journal::checkpoint(const QVector<Account> &entries) -> bool
+{
+    compaction_pool_.waitForDone();
+    const auto lock = std::scoped_lock{mutex_};
+
+    const auto sequence = next_sequence_ - 1;
+
+    toml::array accounts_array;
+    for (const auto &entry : entries) accounts_array.push_back(account_to_table(entry));
+
+    toml::table snapshot;
+    snapshot.insert(SEQUENCE_KEY, sequence);
+    snapshot.insert("accounts", std::move(accounts_array));
+
+    auto stream = std::ostringstream{};
+    stream << snapshot;
+    if (!commit_snapshot(std::move(stream).str(), entries, sequence)) return false;
+
+    // every record is now at or below the snapshot sequence, so the journals can go
+    QFile::remove(compacting_path_);
+    journal_file_.close();
+    journal_file_.setFileName(journal_path_);
+    journal_file_.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    record_count_ = 0;
+
+    return true;
+}
+
+auto Account_Journal::wait_for_compaction() -> void
+{
+    compaction_pool_.waitForDone();
+}
+
+auto Account_Journal::record_count() const -> int
+{
+    const auto lock = std::scoped_lock{mutex_};
+    return record_count_;
+}
+
+auto Account_Journal::apply(toml::table &snapshot, const QVector<Journal_Record> &records) -> void
+{
+    if (records.isEmpty()) return;
+
+    auto *accounts_array = snapshot.get_as<toml::array>("accounts");
+    if (!accounts_array) {
+        snapshot.insert_or_assign("accounts", toml::array{});
+        accounts_array = snapshot.get_as<toml::array>("accounts");
+        if (!accounts_array) return;
+    }
+
+    const auto id_of = [accounts_array](qsizetype i) {
+        const auto *table = (*accounts_array)[static_cast<std::size_t>(i)].as_table();
+        const auto id = table ? (*table)["id"].value_or(std::int64_t{0}) : std::int64_t{0};
+        return id > 0 ? static_cast<Account_Id>(id) : Account_Id{0};
+    };
+    auto positions = index_by_id(static_cast<qsizetype>(accounts_array->size()), id_of);
+
+    // removals only mark their table, so the indexed positions stay valid for the whole batch
+    QVector<bool> removed(static_cast<qsizetype>(accounts_array->size()), false);
+    for (const auto &record : records) {
+        if (record.op == Journal_Op::Add) {
+            positions.insert(record.account.id, static_cast<qsizetype>(accounts_array->size()));
+            accounts_array->push_back(account_to_table(record.account));
+            removed.append(false);
+            continue;
+        }
+
+        const auto it = positions.constFind(record.account.id);
+        if (it == positions.cend()) continue;
+
+        if (record.op == Journal_Op::Remove) {
+            removed[*it] = true;
+            positions.erase(it);
+            continue;
+        }
+
+        auto *table_to_update = (*accounts_array)[static_cast<std::size_t>(*it)].as_table();
+        table_to_update->insert_or_assign("note", record.account.note.toStdString());
+        table_to_update->insert_or_assign("username", record.account.username.toStdString());
+        table_to_update->insert_or_assign("password", record.account.password.toStdString());
+    }
+
+    if (!removed.contains(true)) return;
+
+    toml::array kept;
+    kept.reserve(accounts_array->size());
+    for (qsizetype i = 0; i < removed.size(); ++i) {
+        if (removed[i]) continue;
+        (*accounts_array)[static_cast<std::size_t>(i)].visit([&kept](auto &&node) { kept.push_back(std::move(node)); });
+    }
+    *accounts_array = std::move(kept);
+}
+
+auto Account_Journal::apply(Account_Columns &accounts, const QVector<Journal_Record> &records) -> void
+{
+    if (records.isEmpty()) return;
+
+    auto positions = index_by_id(accounts.size(), [&accounts](qsizetype i) { return accounts.id(static_cast<int>(i)); });
+
+    // removals only mark their entry, so the indexed positions stay valid for the whole batch
+    QVector<bool> removed(accounts.size(), false);
+    for (const auto &record : records) {
+        if (record.op == Journal_Op::Add) {
+            positions.insert(record.account.id, accounts.size());
+            accounts.append(record.account);
+            removed.append(false);
+            continue;
+        }
+
+        const auto it = positions.constFind(record.account.id);
+        if (it == positions.cend()) continue;
+
+        if (record.op == Journal_Op::Remove) {
+            removed[*it] = true;
+            positions.erase(it);
+        } else {
+            accounts.replace(static_cast<int>(*it), record.account);
+        }
+    }
+
+    accounts.remove_marked(removed);
+}
+
+auto Account_Journal::read_records(const QString &path) -> QVector<Journal_Record>
+{
+    QVector<Journal_Record> records;
+
+    auto file = QFile{path};
+    if (!file.open(QIODevice::ReadOnly)) return records;
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty()) continue;
+
+        // a malformed line can only be a write torn by a crash, so nothing after it is trusted
+        const auto data = json::parse(line.constBegin(), line.constEnd(), nullptr, false);
+        if (data.is_discarded() || !data.is_object()) break;
+
+        const auto op = op_from_string(data.value("op", ""s));
+        if (!op || !data.contains("id")) break;
+
+        Journal_Record record;
+        record.op = *op;
+        record.sequence = data.value("seq", std::int64_t{0});
+        record.account.id = data.value("id", Account_Id{0});
+        record.account.note = QString::fromStdString(data.value("note", ""s));
+        record.account.username = QString::fromStdString(data.value("username", ""s));
+        record.account.password = QString::fromStdString(data.value("password", ""s));
+
+        records.append(std::move(record));
+    }
+
+    return records;
+}
+
+auto Account_Journal::open_journal() -> bool
+{
+    journal_file_.setFileName(journal_path_);
+    return journal_file_.open(QIODevice::WriteOnly | QIODevice::Append);
+}
+
+auto Account_Journal::commit_snapshot(const std::string &bytes, const QVector<Account> &entries, std::int64_t sequence) -> bool
+{
+    auto file = QSaveFile{snapshot_path_};
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    file.write(bytes.data(), static_cast<qint64>(bytes.size()));
+    if (!file.commit()) return false;
+
+    Binary_Snapshot::write(Binary_Snapshot::path_for(snapshot_path_), entries, Snapshot_Source::of(snapshot_path_), sequence);
+    return true;
+}
+
+auto Account_Journal::compact() -> void
+{
+    const auto finish = [this] {
+        const auto lock = std::scoped_lock{mutex_};
+        compaction_scheduled_ = false;
+    };
+
+    const auto records = read_records(compacting_path_);
+
+    // the snapshot is only ever written from this thread, so it can be read without the lock
+    std::string document;
+    {
+        auto file = QFile{snapshot_path_};
+        if (file.open(QIODevice::ReadOnly)) document = file.readAll().toStdString();
+    }
+
+    toml::table snapshot;
+    if (!document.empty()) {
+        auto result = toml::parse(document, snapshot_path_.toStdString());
+        if (!result) return finish();
+        snapshot = std::move(result).table();
+    }
+
+    const auto snapshot_sequence = snapshot[SEQUENCE_KEY].value_or(std::int64_t{0});
+
+    QVector<Journal_Record> pending;
+    for (const auto &record : records) {
+        if (record.sequence > snapshot_sequence) pending.append(record);
+    }
+    const auto sequence = pending.isEmpty() ? snapshot_sequence : pending.last().sequence;
+
+    // regions must be resolved before the records are applied, since that replaces the nodes
+    auto patched = patch_updates(document, snapshot, pending, sequence);
+
+    apply(snapshot, pending);
+    snapshot.insert_or_assign(SEQUENCE_KEY, sequence);
+
+    std::string bytes;
+    if (patched) {
+        bytes = std::move(*patched);
+    } else {
+        auto stream = std::ostringstream{};
+        stream << snapshot;
+        bytes = std::move(stream).str();
+    }
+
+    {
+        const auto lock = std::scoped_lock{mutex_};
+
+        if (commit_snapshot(bytes, accounts_from_table(snapshot), sequence)) QFile::remove(compacting_path_);
+        compaction_scheduled_ = false;
+    }
+}
+
+} // namespace core
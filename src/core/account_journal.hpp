@@ -0,0 +1,133 @@
+// =================================================================================
+// core/account_journal.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+#include "core/account_columns.hpp"
+
+#include <QFile>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace core {
+
+/// @enum Journal_Op
+/// @brief The kind of mutation stored in a journal record.
+enum class Journal_Op : std::uint8_t { Add, Update, Remove };
+
+/// @struct Journal_Record
+/// @brief A single account mutation, as appended to the journal.
+struct Journal_Record {
+    Journal_Op op = Journal_Op::Add;
+
+    /// @brief Monotonic sequence number, assigned by the journal on append.
+    std::int64_t sequence = 0;
+
+    /// @brief The account payload; remove records only carry the ID.
+    Account account;
+};
+
+/// @class Account_Journal
+/// @brief A write-ahead log of account mutations layered on top of the TOML snapshot.
+///
+/// Mutations are appended as one JSON line each to a file next to the snapshot
+/// (e.g. "accounts.journal"), so an edit costs a single small write instead of a
+/// full parse and re-serialization of the snapshot. Once enough records pile up,
+/// the journal is rotated and folded back into the snapshot on a background thread.
+///
+/// A batch made up only of updates is folded by patching the changed values in place
+/// (see Toml_Patch) rather than re-serializing the snapshot. Compaction also refreshes
+/// the Binary_Snapshot mirror of the TOML file.
+///
+/// @note The snapshot stores the sequence number of the last record folded into it
+/// under the top-level "journal_sequence" key, which makes replay idempotent if the
+/// application dies between committing a compacted snapshot and deleting the journal.
+class Account_Journal final {
+  public:
+    /// @brief Constructs a journal for the given snapshot file.
+    /// @param snapshot_path The full path to the TOML snapshot (e.g. ".../accounts.toml").
+    explicit Account_Journal(const QString &snapshot_path);
+
+    /// @brief Waits for any in-flight compaction before closing the journal.
+    ~Account_Journal();
+
+    Account_Journal(const Account_Journal &) = delete;
+    auto operator=(const Account_Journal &) -> Account_Journal & = delete;
+
+    /// @brief Appends a record to the journal and flushes it to disk.
+    /// @return True if the record was durably written.
+    auto append(Journal_Record record) -> bool;
+
+    /// @brief Appends a batch of records with a single write and flush.
+    /// @return True if every record was durably written.
+    auto append(QVector<Journal_Record> records) -> bool;
+
+    /// @brief Loads the snapshot entries and applies every journal record newer than them.
+    /// @param load_snapshot Reads the snapshot and stores its journal sequence in the out
+    /// parameter; invoked under the journal lock so that a concurrent compaction cannot
+    /// swap the snapshot between the read and the replay.
+    auto replay(const std::function<Account_Columns(std::int64_t *sequence)> &load_snapshot) const -> Account_Columns;
+
+    /// @brief Schedules a background fold of the journal into the snapshot.
+    auto request_compaction() -> void;
+
+    /// @brief Replaces the snapshot with the given entries and discards the journal.
+    /// @param entries Every account, in file order, including all journaled changes.
+    /// @return True if the new snapshot was committed.
+    auto checkpoint(const QVector<Account> &entries) -> bool;
+
+    /// @brief Blocks until any scheduled compaction has finished.
+    auto wait_for_compaction() -> void;
+
+    /// @brief Returns the number of records in the live journal file.
+    auto record_count() const -> int;
+
+    /// @brief Applies a batch of records, in order, to a snapshot table.
+    ///
+    /// Accounts are found through an ID index built once per batch, and removed tables
+    /// are only dropped in a single pass at the end, so a batch of M records over N
+    /// accounts costs O(N + M). Records targeting an account that does not exist are skipped.
+    static auto apply(toml::table &snapshot, const QVector<Journal_Record> &records) -> void;
+
+    /// @brief Applies a batch of records, in order, to the loaded accounts, like the table overload.
+    static auto apply(Account_Columns &accounts, const QVector<Journal_Record> &records) -> void;
+
+  private:
+    /// @brief Reads every well-formed record from a journal file, stopping at a torn tail.
+    static auto read_records(const QString &path) -> QVector<Journal_Record>;
+
+    /// @brief Opens the live journal file for appending.
+    auto open_journal() -> bool;
+
+    /// @brief Atomically writes the TOML snapshot and refreshes its binary mirror.
+    /// @note The caller must hold the journal lock.
+    auto commit_snapshot(const std::string &bytes, const QVector<Account> &entries, std::int64_t sequence) -> bool;
+
+    /// @brief Folds the rotated journal into the snapshot; runs on the compaction thread.
+    auto compact() -> void;
+
+  private:
+    QString snapshot_path_;
+    QString journal_path_;
+    QString compacting_path_;
+
+    /// @brief Guards the journal file, the sequence counter and the snapshot commit.
+    mutable std::mutex mutex_;
+    QFile journal_file_;
+    std::int64_t next_sequence_ = 1;
+    int record_count_ = 0;
+    bool compaction_scheduled_ = false;
+
+    /// @brief A single-threaded pool so that at most one compaction runs at a time.
+    QThreadPool compaction_pool_;
+};
+
+} // namespace core
@@ -0,0 +1,495 @@
+// =================================================================================
+// core/account_reader.cc
+// =================================================================================
+
+#include "account_reader.hpp"
+
+#include <QString>
+
+#include <limits>
+#include <optional>
+#include <string>
+
+using namespace std::literals;
+
+namespace core {
+
+namespace {
+
+/// @brief A scalar value as understood by the reader.
+struct Value {
+    enum class Kind { String, Integer } kind = Kind::String;
+    std::string_view string;
+    std::int64_t integer = 0;
+};
+
+/// @class Scanner
+/// @brief A cursor over the document with just enough TOML to read the accounts array.
+///
+/// Every member returns an empty optional (or false) as soon as the input leaves the
+/// supported subset; no error is ever reported, the caller simply falls back.
+class Scanner {
+  public:
+    explicit Scanner(std::string_view document)
+        : doc_{document}
+    {
+        if (doc_.starts_with("\xEF\xBB\xBF"sv)) pos_ = 3;
+    }
+
+    auto at_end() const -> bool
+    {
+        return pos_ >= doc_.size();
+    }
+
+    auto peek(size_t offset = 0) const -> char
+    {
+        return pos_ + offset < doc_.size() ? doc_[pos_ + offset] : '\0';
+    }
+
+    auto skip_whitespace() -> void
+    {
+        while (peek() == ' ' || peek() == '\t') ++pos_;
+    }
+
+    auto consume_newline() -> bool
+    {
+        if (peek() == '\n') {
+            pos_ += 1;
+            return true;
+        }
+        if (peek() == '\r' && peek(1) == '\n') {
+            pos_ += 2;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Consumes trailing whitespace and an optional comment up to the end of the line.
+    auto finish_line() -> bool
+    {
+        skip_whitespace();
+        if (peek() == '#') {
+            while (!at_end() && peek() != '\n' && peek() != '\r') {
+                if (is_control(peek())) return false;
+                ++pos_;
+            }
+        }
+        return at_end() || consume_newline();
+    }
+
+    /// @brief Parses a bare or quoted key; dotted keys are rejected.
+    auto parse_key(std::string &scratch) -> std::optional<std::string_view>
+    {
+        std::optional<std::string_view> key;
+
+        if (peek() == '"') {
+            ++pos_;
+            key = parse_basic_string(scratch);
+        } else if (peek() == '\'') {
+            ++pos_;
+            key = parse_literal_string();
+        } else {
+            const auto start = pos_;
+            while (is_bare_key_char(peek())) ++pos_;
+            if (pos_ != start) key = doc_.substr(start, pos_ - start);
+        }
+
+        if (!key) return std::nullopt;
+
+        skip_whitespace();
+        if (peek() == '.') return std::nullopt;
+        return key;
+    }
+
+    /// @brief Parses a string or a decimal integer.
+    auto parse_value(std::string &scratch) -> std::optional<Value>
+    {
+        std::optional<std::string_view> string;
+
+        if (doc_.substr(pos_).starts_with("\"\"\""sv)) {
+            pos_ += 3;
+            string = parse_multiline_basic_string(scratch);
+        } else if (doc_.substr(pos_).starts_with("'''"sv)) {
+            pos_ += 3;
+            string = parse_multiline_literal_string(scratch);
+        } else if (peek() == '"') {
+            ++pos_;
+            string = parse_basic_string(scratch);
+        } else if (peek() == '\'') {
+            ++pos_;
+            string = parse_literal_string();
+        } else {
+            const auto integer = parse_integer();
+            if (!integer) return std::nullopt;
+            return Value{.kind = Value::Kind::Integer, .string = {}, .integer = *integer};
+        }
+
+        if (!string) return std::nullopt;
+        return Value{.kind = Value::Kind::String, .string = *string, .integer = 0};
+    }
+
+    /// @brief Parses the inside of a [[header]] and its closing brackets.
+    auto parse_array_table_header(std::string &scratch) -> std::optional<std::string_view>
+    {
+        skip_whitespace();
+        const auto name = parse_key(scratch);
+        if (!name || peek() != ']' || peek(1) != ']') return std::nullopt;
+
+        pos_ += 2;
+        return name;
+    }
+
+    auto advance(size_t count) -> void
+    {
+        pos_ += count;
+    }
+
+  private:
+    static auto is_bare_key_char(char c) -> bool
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+    }
+
+    static auto is_control(char c) -> bool
+    {
+        const auto byte = static_cast<unsigned char>(c);
+        return (byte < 0x20 && c != '\t') || byte == 0x7F;
+    }
+
+    static auto hex_value(char c) -> int
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static auto append_utf8(std::string &out, std::uint32_t cp) -> void
+    {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    /// @brief Decodes the escape sequence after a backslash into the output buffer.
+    auto parse_escape(std::string &out) -> bool
+    {
+        const char c = peek();
+        ++pos_;
+
+        switch (c) {
+        case 'b': out += '\b'; return true;
+        case 't': out += '\t'; return true;
+        case 'n': out += '\n'; return true;
+        case 'f': out += '\f'; return true;
+        case 'r': out += '\r'; return true;
+        case '"': out += '"'; return true;
+        case '\\': out += '\\'; return true;
+        case 'u':
+        case 'U': {
+            const int digits = c == 'u' ? 4 : 8;
+            std::uint32_t cp = 0;
+            for (int i = 0; i < digits; ++i) {
+                const int value = hex_value(peek());
+                if (value < 0) return false;
+                cp = (cp << 4) | static_cast<std::uint32_t>(value);
+                ++pos_;
+            }
+            if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return false;
+            append_utf8(out, cp);
+            return true;
+        }
+        default: return false;
+        }
+    }
+
+    /// @brief Parses a "basic string" after its opening quote.
+    /// @note The result points into the document unless the string contains escapes.
+    auto parse_basic_string(std::string &scratch) -> std::optional<std::string_view>
+    {
+        const auto start = pos_;
+        bool copying = false;
+
+        while (!at_end()) {
+            const char c = peek();
+            if (c == '"') {
+                ++pos_;
+                if (copying) return std::string_view{scratch};
+                return doc_.substr(start, pos_ - 1 - start);
+            }
+
+            if (c == '\\') {
+                if (!copying) {
+                    scratch.assign(doc_.substr(start, pos_ - start));
+                    copying = true;
+                }
+                ++pos_;
+                if (!parse_escape(scratch)) return std::nullopt;
+                continue;
+            }
+
+            if (is_control(c)) return std::nullopt;
+            if (copying) scratch += c;
+            ++pos_;
+        }
+
+        return std::nullopt;
+    }
+
+    /// @brief Parses a 'literal string' after its opening quote.
+    auto parse_literal_string() -> std::optional<std::string_view>
+    {
+        const auto start = pos_;
+        while (!at_end() && peek() != '\'') {
+            if (is_control(peek())) return std::nullopt;
+            ++pos_;
+        }
+
+        if (at_end()) return std::nullopt;
+        ++pos_;
+        return doc_.substr(start, pos_ - 1 - start);
+    }
+
+    /// @brief Consumes the closing run of a multi-line string, which may carry up to two
+    /// extra quotes that belong to the content.
+    auto close_multiline(char quote, std::string &out) -> bool
+    {
+        size_t run = 0;
+        while (peek(run) == quote) ++run;
+        if (run > 5) return false;
+
+        out.append(run - 3, quote);
+        pos_ += run;
+        return true;
+    }
+
+    /// @brief Parses a """multi-line basic string""" after its opening delimiter.
+    auto parse_multiline_basic_string(std::string &scratch) -> std::optional<std::string_view>
+    {
+        scratch.clear();
+        consume_newline();
+
+        while (!at_end()) {
+            const char c = peek();
+
+            if (c == '"' && peek(1) == '"' && peek(2) == '"') {
+                if (!close_multiline('"', scratch)) return std::nullopt;
+                return std::string_view{scratch};
+            }
+
+            if (c == '\\') {
+                ++pos_;
+
+                // a line-ending backslash trims all whitespace up to the next content
+                const auto escape_start = pos_;
+                skip_whitespace();
+                if (peek() == '\n' || peek() == '\r') {
+                    while (consume_newline() || peek() == ' ' || peek() == '\t') {
+                        if (peek() == ' ' || peek() == '\t') ++pos_;
+                    }
+                    continue;
+                }
+
+                pos_ = escape_start;
+                if (!parse_escape(scratch)) return std::nullopt;
+                continue;
+            }
+
+            if (consume_newline()) {
+                scratch += '\n';
+                continue;
+            }
+
+            if (is_control(c)) return std::nullopt;
+            scratch += c;
+            ++pos_;
+        }
+
+        return std::nullopt;
+    }
+
+    /// @brief Parses a '''multi-line literal string''' after its opening delimiter.
+    auto parse_multiline_literal_string(std::string &scratch) -> std::optional<std::string_view>
+    {
+        scratch.clear();
+        consume_newline();
+
+        while (!at_end()) {
+            if (peek() == '\'' && peek(1) == '\'' && peek(2) == '\'') {
+                if (!close_multiline('\'', scratch)) return std::nullopt;
+                return std::string_view{scratch};
+            }
+
+            if (consume_newline()) {
+                scratch += '\n';
+                continue;
+            }
+
+            if (is_control(peek())) return std::nullopt;
+            scratch += peek();
+            ++pos_;
+        }
+
+        return std::nullopt;
+    }
+
+    /// @brief Parses a decimal integer with optional sign and digit separators.
+    auto parse_integer() -> std::optional<std::int64_t>
+    {
+        bool negative = false;
+        if (peek() == '+' || peek() == '-') {
+            negative = peek() == '-';
+            ++pos_;
+        }
+
+        const auto start = pos_;
+        std::uint64_t magnitude = 0;
+        bool previous_was_digit = false;
+
+        while (true) {
+            const char c = peek();
+            if (c >= '0' && c <= '9') {
+                const auto digit = static_cast<std::uint64_t>(c - '0');
+                if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) return std::nullopt;
+
+                magnitude = magnitude * 10 + digit;
+                previous_was_digit = true;
+            } else if (c == '_' && previous_was_digit && peek(1) >= '0' && peek(1) <= '9') {
+                previous_was_digit = false;
+            } else {
+                break;
+            }
+            ++pos_;
+        }
+
+        // leading zeros are not valid TOML
+        if (pos_ == start || (doc_[start] == '0' && pos_ - start > 1)) return std::nullopt;
+
+        constexpr auto max = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+        if (magnitude > max + (negative ? 1 : 0)) return std::nullopt;
+
+        if (negative) return magnitude == max + 1 ? std::numeric_limits<std::int64_t>::min() : -static_cast<std::int64_t>(magnitude);
+        return static_cast<std::int64_t>(magnitude);
+    }
+
+  private:
+    std::string_view doc_;
+    size_t pos_ = 0;
+};
+
+/// @brief The fields of the account table currently being read.
+struct Pending_Account {
+    Account_Fields fields;
+    bool has_id = false;
+    bool has_note = false;
+    bool has_username = false;
+    bool has_password = false;
+};
+
+} // namespace
+
+auto scan_accounts(std::string_view document, const std::function<void(const Account_Fields &)> &on_account, std::int64_t *sequence)
+    -> bool
+{
+    auto scanner = Scanner{document};
+    *sequence = 0;
+
+    // decoded strings live here when they cannot point into the document
+    std::string key_scratch, note_scratch, username_scratch, password_scratch, other_scratch;
+
+    bool in_accounts = false;
+    bool has_sequence = false;
+    Pending_Account pending;
+
+    while (!scanner.at_end()) {
+        scanner.skip_whitespace();
+        if (scanner.finish_line()) continue;
+
+        if (scanner.peek() == '[') {
+            if (scanner.peek(1) != '[') return false;
+            scanner.advance(2);
+
+            const auto name = scanner.parse_array_table_header(key_scratch);
+            if (!name || *name != "accounts"sv || !scanner.finish_line()) return false;
+
+            if (in_accounts) on_account(pending.fields);
+            in_accounts = true;
+            pending = {};
+            continue;
+        }
+
+        const auto key = scanner.parse_key(key_scratch);
+        if (!key || scanner.peek() != '=') return false;
+        scanner.advance(1);
+        scanner.skip_whitespace();
+
+        std::string *scratch = &other_scratch;
+        std::string_view *target = nullptr;
+        bool *seen = nullptr;
+
+        if (in_accounts) {
+            if (*key == "note"sv) {
+                scratch = &note_scratch, target = &pending.fields.note, seen = &pending.has_note;
+            } else if (*key == "username"sv) {
+                scratch = &username_scratch, target = &pending.fields.username, seen = &pending.has_username;
+            } else if (*key == "password"sv) {
+                scratch = &password_scratch, target = &pending.fields.password, seen = &pending.has_password;
+            }
+        }
+
+        const auto value = scanner.parse_value(*scratch);
+        if (!value || !scanner.finish_line()) return false;
+
+        if (target) {
+            // duplicate keys and non-string credentials are errors toml++ should report
+            if (*seen || value->kind != Value::Kind::String) return false;
+            *target = value->string;
+            *seen = true;
+        } else if (in_accounts && *key == "id"sv) {
+            if (pending.has_id || value->kind != Value::Kind::Integer) return false;
+            pending.fields.id = value->integer > 0 ? static_cast<Account_Id>(value->integer) : 0;
+            pending.has_id = true;
+        } else if (!in_accounts && *key == "journal_sequence"sv) {
+            if (has_sequence || value->kind != Value::Kind::Integer) return false;
+            *sequence = value->integer;
+            has_sequence = true;
+        }
+    }
+
+    if (in_accounts) on_account(pending.fields);
+    return true;
+}
+
+auto read_accounts(std::string_view document, QVector<Account> &entries, std::int64_t *sequence) -> bool
+{
+    const auto to_qstring = [](std::string_view utf8) { return QString::fromUtf8(utf8.data(), static_cast<qsizetype>(utf8.size())); };
+
+    const bool ok = scan_accounts(
+        document,
+        [&](const Account_Fields &fields) {
+            Account account;
+            account.id = fields.id;
+            account.note = to_qstring(fields.note);
+            account.username = to_qstring(fields.username);
+            account.password = to_qstring(fields.password);
+            entries.append(std::move(account));
+        },
+        sequence);
+
+    if (!ok) entries.clear();
+    return ok;
+}
+
+} // namespace core
@@ -0,0 +1,46 @@
+// =================================================================================
+// core/account_reader.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace core {
+
+/// @struct Account_Fields
+/// @brief The raw UTF-8 fields of one [[accounts]] table.
+/// @note The views are only valid for the duration of the callback they are passed to.
+struct Account_Fields {
+    Account_Id id = 0;
+    std::string_view note;
+    std::string_view username;
+    std::string_view password;
+};
+
+/// @brief Streams every [[accounts]] table out of a TOML document without building a DOM.
+///
+/// Only the shape written by this application is understood: top-level integer keys
+/// followed by an array of tables whose values are strings or decimal integers, with
+/// comments and blank lines anywhere. Anything else (other tables, inline tables,
+/// arrays, dotted keys, floats, dates, malformed input) makes the scan fail, and the
+/// caller is expected to fall back to toml++.
+///
+/// @param document The complete UTF-8 file contents.
+/// @param on_account Invoked once per account table, in file order.
+/// @param sequence Receives the top-level "journal_sequence" value, or 0 if absent.
+/// @return False if the document needs the generic parser.
+auto scan_accounts(std::string_view document, const std::function<void(const Account_Fields &)> &on_account, std::int64_t *sequence)
+    -> bool;
+
+/// @brief Streams the accounts of a TOML document straight into a list of entries.
+/// @return False if the document needs the generic parser; entries is left empty in that case.
+auto read_accounts(std::string_view document, QVector<Account> &entries, std::int64_t *sequence) -> bool;
+
+} // namespace core
@@ -0,0 +1,136 @@
+// =================================================================================
+// core/account_search.cc
+// =================================================================================
+
+#include "account_search.hpp"
+
+#include <algorithm>
+
+namespace core {
+
+/// @brief The fraction of query trigrams, in percent, an account must share to match.
+static constexpr int MIN_MATCH_PERCENT = 50;
+
+auto Account_Search::insert(const Account_View &account) -> void
+{
+    remove(account.id);
+
+    auto key = make_key(account.note, account.username);
+    for (const auto trigram : trigrams_of(key)) postings_[trigram].insert(account.id);
+    keys_.insert(account.id, std::move(key));
+}
+
+auto Account_Search::remove(Account_Id id) -> void
+{
+    const auto it = keys_.constFind(id);
+    if (it == keys_.constEnd()) return;
+
+    for (const auto trigram : trigrams_of(it.value())) {
+        auto posting = postings_.find(trigram);
+        if (posting == postings_.end()) continue;
+
+        posting->remove(id);
+        if (posting->isEmpty()) postings_.erase(posting);
+    }
+
+    keys_.erase(it);
+}
+
+auto Account_Search::clear() -> void
+{
+    postings_.clear();
+    keys_.clear();
+}
+
+auto Account_Search::size() const -> int
+{
+    return static_cast<int>(keys_.size());
+}
+
+auto Account_Search::search(const QString &query) const -> QVector<Account_Id>
+{
+    const QByteArray needle = query.trimmed().toLower().toUtf8();
+    if (needle.isEmpty()) return {};
+
+    const auto query_trigrams = trigrams_of(needle);
+    if (query_trigrams.isEmpty()) return {};
+
+    QVector<const QSet<Account_Id> *> lists;
+    lists.reserve(query_trigrams.size());
+    for (const auto trigram : query_trigrams) {
+        const auto posting = postings_.constFind(trigram);
+        if (posting != postings_.constEnd()) lists.append(&posting.value());
+    }
+
+    const auto trigram_count = static_cast<int>(query_trigrams.size());
+    const int min_score = std::max(1, (trigram_count * MIN_MATCH_PERCENT + 99) / 100);
+    if (lists.size() < min_score) return {};
+
+    // an account sharing min_score of the trigrams must appear in one of the
+    // (count - min_score + 1) shortest lists, so only those can add candidates
+    std::ranges::sort(lists, {}, [](const QSet<Account_Id> *list) { return list->size(); });
+    const auto seed_lists = static_cast<qsizetype>(trigram_count - min_score + 1);
+
+    QHash<Account_Id, int> scores;
+    for (qsizetype i = 0; i < lists.size(); ++i) {
+        const bool may_add = i < seed_lists;
+        for (const auto id : *lists[i]) {
+            if (may_add) {
+                ++scores[id];
+            } else if (auto score = scores.find(id); score != scores.end()) {
+                ++*score;
+            }
+        }
+    }
+
+    struct Match {
+        Account_Id id;
+        bool exact;
+        int score;
+        qsizetype length;
+    };
+
+    QVector<Match> matches;
+    for (auto it = scores.cbegin(); it != scores.cend(); ++it) {
+        if (it.value() < min_score) continue;
+
+        const QByteArray key = keys_.value(it.key());
+        matches.append(Match{.id = it.key(), .exact = key.contains(needle), .score = it.value(), .length = key.size()});
+    }
+
+    std::ranges::sort(matches, [](const Match &a, const Match &b) {
+        if (a.exact != b.exact) return a.exact;
+        if (a.score != b.score) return a.score > b.score;
+        return a.length < b.length;
+    });
+
+    QVector<Account_Id> ids;
+    ids.reserve(matches.size());
+    for (const auto &match : matches) ids.append(match.id);
+    return ids;
+}
+
+auto Account_Search::make_key(QUtf8StringView note, QUtf8StringView username) -> QByteArray
+{
+    return (note.toString() + "\n" + username.toString()).toLower().toUtf8();
+}
+
+auto Account_Search::trigrams_of(const QByteArray &key) -> QVector<std::uint32_t>
+{
+    QVector<std::uint32_t> trigrams;
+    if (key.size() < 3) return trigrams;
+
+    trigrams.reserve(key.size() - 2);
+    for (qsizetype i = 0; i + 2 < key.size(); ++i) {
+        const auto a = static_cast<std::uint8_t>(key[i]);
+        const auto b = static_cast<std::uint8_t>(key[i + 1]);
+        const auto c = static_cast<std::uint8_t>(key[i + 2]);
+        trigrams.append(static_cast<std::uint32_t>(a) << 16 | static_cast<std::uint32_t>(b) << 8 | c);
+    }
+
+    std::ranges::sort(trigrams);
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+} // namespace core
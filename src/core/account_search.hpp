@@ -0,0 +1,63 @@
+// =================================================================================
+// core/account_search.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+#include "core/account_columns.hpp"
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+namespace core {
+
+/// @class Account_Search
+/// @brief An incrementally maintained trigram index over account notes and usernames.
+///
+/// Every account contributes the trigrams of its case-folded "note\nusername" key.
+/// A query is split into trigrams as well, and an account matches when it shares at
+/// least half of them, which tolerates typos and transpositions. Adding, updating or
+/// removing an account only touches the posting lists of that account's own trigrams.
+class Account_Search final {
+  public:
+    /// @brief Indexes an account, replacing its previous entry if it was already indexed.
+    auto insert(const Account_View &account) -> void;
+
+    /// @brief Removes an account from the index; unknown IDs are ignored.
+    auto remove(Account_Id id) -> void;
+
+    /// @brief Removes every account from the index.
+    auto clear() -> void;
+
+    /// @brief Returns the number of indexed accounts.
+    auto size() const -> int;
+
+    /// @brief Returns the IDs of the accounts matching a query, best match first.
+    ///
+    /// Exact substring matches rank above fuzzy ones, then accounts sharing more
+    /// trigrams with the query, then shorter keys. Queries shorter than a trigram have
+    /// nothing to look up and match nothing; see Substring_Filter for those.
+    auto search(const QString &query) const -> QVector<Account_Id>;
+
+  private:
+    /// @brief Builds the case-folded UTF-8 key that is indexed for an account.
+    static auto make_key(QUtf8StringView note, QUtf8StringView username) -> QByteArray;
+
+    /// @brief Returns the distinct trigrams of a key, each packed into the low 24 bits.
+    static auto trigrams_of(const QByteArray &key) -> QVector<std::uint32_t>;
+
+  private:
+    /// @brief Maps every trigram to the accounts whose key contains it.
+    QHash<std::uint32_t, QSet<Account_Id>> postings_;
+
+    /// @brief The indexed key of every account, used to unindex and to rank matches.
+    QHash<Account_Id, QByteArray> keys_;
+};
+
+} // namespace core
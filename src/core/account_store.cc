@@ -0,0 +1,259 @@
+// =================================================================================
+// core/account_store.cc
+// =================================================================================
+
+#include "account_store.hpp"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QMetaObject>
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+namespace core {
+
+/// @brief How long the store must stay idle before pending edits are written.
+static constexpr int FLUSH_DELAY_MS = 250;
+
+Account_Store::Account_Store(Account_Config *config, QObject *parent)
+    : QObject{parent}
+    , config_{config}
+    , accounts_{config->get_accounts()}
+{
+    index_.reserve(accounts_.size());
+    for (int i = 0; i < size(); ++i) {
+        index_.insert(accounts_.id(i), i);
+        search_.insert(accounts_.at(i));
+    }
+
+    flush_pool_.setMaxThreadCount(1);
+
+    flush_timer_.setSingleShot(true);
+    flush_timer_.setInterval(FLUSH_DELAY_MS);
+    QObject::connect(&flush_timer_, &QTimer::timeout, this, &Account_Store::schedule_flush);
+}
+
+Account_Store::~Account_Store()
+{
+    flush();
+}
+
+auto Account_Store::accounts() const -> const Account_Columns &
+{
+    return accounts_;
+}
+
+auto Account_Store::size() const -> int
+{
+    return accounts_.size();
+}
+
+auto Account_Store::at(int index) const -> Account_View
+{
+    return accounts_.at(index);
+}
+
+auto Account_Store::index_of(Account_Id id) const -> int
+{
+    return index_.value(id, -1);
+}
+
+auto Account_Store::find(Account_Id id) const -> std::optional<Account_View>
+{
+    const int index = index_of(id);
+    if (index < 0) return std::nullopt;
+    return accounts_.at(index);
+}
+
+auto Account_Store::search(const QString &query) const -> QVector<Account_Id>
+{
+    auto ids = filter(query);
+    if (query.trimmed().toUtf8().size() < 3) return ids;
+
+    const auto exact = QSet<Account_Id>{ids.cbegin(), ids.cend()};
+    for (const auto id : search_.search(query)) {
+        if (!exact.contains(id)) ids.append(id);
+    }
+    return ids;
+}
+
+auto Account_Store::filter(const QString &query) const -> QVector<Account_Id>
+{
+    const QByteArray needle = query.trimmed().toUtf8();
+    const auto substring = Substring_Filter{std::string_view{needle.constData(), static_cast<std::size_t>(needle.size())}};
+
+    const auto notes = accounts_.find(Account_Columns::Field::Note, substring);
+    const auto usernames = accounts_.find(Account_Columns::Field::Username, substring);
+
+    QVector<int> positions;
+    positions.reserve(notes.size() + usernames.size());
+    std::ranges::set_union(notes, usernames, std::back_inserter(positions));
+
+    QVector<Account_Id> ids;
+    ids.reserve(positions.size());
+    for (const int position : positions) ids.append(accounts_.id(position));
+    return ids;
+}
+
+auto Account_Store::add(Account account) -> Account_Id
+{
+    do {
+        account.id = generate_account_id();
+    } while (index_.contains(account.id));
+
+    index_.insert(account.id, size());
+    accounts_.append(account);
+    search_.insert(accounts_.at(size() - 1));
+
+    mark_dirty({.op = Journal_Op::Add, .account = account});
+    emit accounts_inserted(size() - 1, size() - 1);
+    return account.id;
+}
+
+auto Account_Store::update(Account_Id id, const Account &account) -> bool
+{
+    const int index = index_of(id);
+    if (index < 0) return false;
+
+    auto record = Journal_Record{.op = Journal_Op::Update, .account = account};
+    record.account.id = id;
+    accounts_.replace(index, record.account);
+    search_.insert(accounts_.at(index));
+
+    mark_dirty(std::move(record));
+    emit accounts_changed(index, index, {id});
+    return true;
+}
+
+auto Account_Store::remove(Account_Id id) -> bool
+{
+    const int index = index_of(id);
+    if (index < 0) return false;
+
+    accounts_.remove_at(index);
+    index_.remove(id);
+    search_.remove(id);
+    for (int i = index; i < size(); ++i) index_[accounts_.id(i)] = i;
+
+    auto record = Journal_Record{.op = Journal_Op::Remove, .account = {}};
+    record.account.id = id;
+    mark_dirty(std::move(record));
+    emit accounts_removed(index, index, {id});
+    return true;
+}
+
+auto Account_Store::import_accounts(const QVector<Account> &accounts) -> Import_Summary
+{
+    Import_Summary summary;
+
+    // views into the username arena and into the UTF-8 copies below; both stay put
+    // until the first account is appended
+    std::unordered_set<std::string_view> usernames;
+    usernames.reserve(static_cast<std::size_t>(size() + accounts.size()));
+    for (int i = 0; i < size(); ++i) {
+        const auto username = accounts_.field(i, Account_Columns::Field::Username);
+        usernames.emplace(reinterpret_cast<const char *>(username.data()), static_cast<std::size_t>(username.size()));
+    }
+
+    QVector<QByteArray> imported_usernames;
+    imported_usernames.reserve(accounts.size());
+
+    QVector<const Account *> accepted;
+    for (const auto &account : accounts) {
+        if (account.username.isEmpty() || account.password.isEmpty()) {
+            ++summary.incomplete;
+            continue;
+        }
+
+        const auto &username = imported_usernames.emplaceBack(account.username.toUtf8());
+        if (!usernames.emplace(username.constData(), static_cast<std::size_t>(username.size())).second) {
+            ++summary.duplicates;
+            continue;
+        }
+
+        accepted.append(&account);
+    }
+
+    for (const auto *account : accepted) {
+        auto record = Journal_Record{.op = Journal_Op::Add, .account = *account};
+        do {
+            record.account.id = generate_account_id();
+        } while (index_.contains(record.account.id));
+
+        index_.insert(record.account.id, size());
+        accounts_.append(record.account);
+        search_.insert(accounts_.at(size() - 1));
+        pending_.append(std::move(record));
+    }
+
+    summary.added = static_cast<int>(accepted.size());
+    if (summary.added > 0) {
+        flush_timer_.stop();
+        schedule_flush();
+        emit accounts_inserted(size() - summary.added, size() - 1);
+    }
+
+    return summary;
+}
+
+auto Account_Store::flush() -> void
+{
+    flush_timer_.stop();
+    flush_pool_.waitForDone();
+
+    // a background flush that just failed has queued its batch for a requeue; take it back first
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+    flush_timer_.stop();
+
+    if (pending_.isEmpty()) return;
+
+    auto batch = std::exchange(pending_, {});
+    if (!config_->commit(batch)) requeue(std::move(batch));
+}
+
+auto Account_Store::mark_dirty(Journal_Record record) -> void
+{
+    // an update can replace the latest pending add or update of the same account
+    if (record.op == Journal_Op::Update) {
+        for (auto it = pending_.rbegin(); it != pending_.rend(); ++it) {
+            if (it->account.id != record.account.id) continue;
+            if (it->op == Journal_Op::Remove) break;
+
+            it->account = record.account;
+            flush_timer_.start();
+            return;
+        }
+    }
+
+    pending_.append(std::move(record));
+    flush_timer_.start();
+}
+
+auto Account_Store::schedule_flush() -> void
+{
+    if (pending_.isEmpty()) return;
+
+    flush_pool_.start([this, batch = std::exchange(pending_, {})]() mutable {
+        if (config_->commit(batch)) return;
+
+        // pending_ belongs to the owning thread, so the batch is handed back there
+        QMetaObject::invokeMethod(this, [this, batch = std::move(batch)]() mutable { requeue(std::move(batch)); }, Qt::QueuedConnection);
+    });
+}
+
+auto Account_Store::requeue(QVector<Journal_Record> batch) -> void
+{
+    // the failed records are older than anything edited since, so they go first
+    batch.append(std::move(pending_));
+    pending_ = std::move(batch);
+
+    flush_timer_.start();
+    emit flush_failed();
+}
+
+} // namespace core
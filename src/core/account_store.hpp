@@ -0,0 +1,148 @@
+// =================================================================================
+// core/account_store.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+#include "core/account_columns.hpp"
+#include "core/account_journal.hpp"
+#include "core/account_search.hpp"
+
+#include <QHash>
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+
+#include <optional>
+
+namespace core {
+
+/// @struct Import_Summary
+/// @brief The outcome of adding a batch of imported accounts to the store.
+struct Import_Summary {
+    int added = 0;
+    int duplicates = 0;
+    int incomplete = 0;
+};
+
+/// @class Account_Store
+/// @brief A resident, load-once view of all accounts with write-behind persistence.
+///
+/// The store reads the accounts through Account_Config exactly once, then serves
+/// every read from memory, where they are kept in columnar form. Edits are applied to memory immediately and queued as
+/// dirty records; a burst of edits is coalesced into a single flush that runs on a
+/// background thread once the store has been idle for a short while.
+///
+/// Accounts are addressed by their persistent ID; the position of an account in
+/// accounts() is only a display order and may change when other accounts are removed.
+/// Every change is announced right after it was applied, with the range of positions
+/// it touched, so views can update just those rows.
+class Account_Store final : public QObject {
+    Q_OBJECT
+
+  public:
+    /// @brief Constructs the store and loads all accounts from the configuration.
+    /// @param config The account configuration used as the backing file.
+    /// @param parent The parent QObject.
+    explicit Account_Store(Account_Config *config, QObject *parent = nullptr);
+
+    /// @brief Flushes any pending edits and waits for them to reach the disk.
+    ~Account_Store() override;
+
+    /// @brief Returns all accounts currently held in memory.
+    auto accounts() const -> const Account_Columns &;
+
+    /// @brief Returns the number of accounts.
+    auto size() const -> int;
+
+    /// @brief Returns a view of the account at a given position.
+    /// @note Views are invalidated by the next add, update or remove.
+    auto at(int index) const -> Account_View;
+
+    /// @brief Returns the position of the account with the given ID, or -1 if there is none.
+    auto index_of(Account_Id id) const -> int;
+
+    /// @brief Returns a view of the account with the given ID, if there is one.
+    auto find(Account_Id id) const -> std::optional<Account_View>;
+
+    /// @brief Returns the IDs of the accounts whose note or username match a query, best match first.
+    ///
+    /// Accounts containing the query as a substring are found with filter() and come
+    /// first, in store order. Queries of at least a trigram then add the fuzzy matches of
+    /// the trigram index that are not substring hits, such as typos.
+    auto search(const QString &query) const -> QVector<Account_Id>;
+
+    /// @brief Returns the IDs of the accounts whose note or username contain a substring, in store order.
+    /// @see Substring_Filter
+    auto filter(const QString &query) const -> QVector<Account_Id>;
+
+    /// @brief Appends a new account, assigning it a fresh ID.
+    /// @return The ID of the new account.
+    auto add(Account account) -> Account_Id;
+
+    /// @brief Replaces the account with the given ID; the ID itself is kept.
+    /// @return False if there is no such account.
+    auto update(Account_Id id, const Account &account) -> bool;
+
+    /// @brief Removes the account with the given ID.
+    /// @return False if there is no such account.
+    auto remove(Account_Id id) -> bool;
+
+    /// @brief Adds a batch of accounts, skipping incomplete ones and usernames that already exist.
+    ///
+    /// Every added account gets a fresh ID, and the whole batch is handed to the flush
+    /// thread as a single journal write right away.
+    auto import_accounts(const QVector<Account> &accounts) -> Import_Summary;
+
+    /// @brief Writes all pending edits immediately and blocks until they are on disk.
+    /// @note Edits that fail to persist stay pending and are retried by the next flush.
+    auto flush() -> void;
+
+  signals:
+    /// @brief Emitted on the owning thread when a flush fails to persist; its records are kept for a retry.
+    auto flush_failed() -> void;
+
+    /// @brief Emitted after accounts were appended at the positions first to last, inclusive.
+    auto accounts_inserted(int first, int last) -> void;
+
+    /// @brief Emitted after the accounts at the positions first to last were removed; later accounts moved up.
+    /// @param ids The IDs of the removed accounts, in position order.
+    auto accounts_removed(int first, int last, const QVector<Account_Id> &ids) -> void;
+
+    /// @brief Emitted after the accounts at the positions first to last were replaced in place.
+    /// @param ids The IDs of the changed accounts, in position order.
+    auto accounts_changed(int first, int last, const QVector<Account_Id> &ids) -> void;
+
+  private:
+    /// @brief Queues a record, folding it into an earlier pending edit where possible.
+    auto mark_dirty(Journal_Record record) -> void;
+
+    /// @brief Hands the pending records to the flush thread as one batch.
+    auto schedule_flush() -> void;
+
+    /// @brief Puts a batch that failed to persist back in front of the pending records and retries it later.
+    auto requeue(QVector<Journal_Record> batch) -> void;
+
+  private:
+    Account_Config *config_;
+    Account_Columns accounts_;
+
+    /// @brief Maps every account ID to its position in accounts_.
+    QHash<Account_Id, int> index_;
+
+    /// @brief The trigram index over every account's note and username.
+    Account_Search search_;
+
+    /// @brief Edits that have been applied in memory but not yet written.
+    QVector<Journal_Record> pending_;
+
+    /// @brief Restarted on every edit so that bursts collapse into one flush.
+    QTimer flush_timer_;
+
+    /// @brief A single-threaded pool so that batches are written in order.
+    QThreadPool flush_pool_;
+};
+
+} // namespace core
@@ -0,0 +1,121 @@
+// =================================================================================
+// core/asset_pack.cc
+// =================================================================================
+
+#include "asset_pack.hpp"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+
+#include <bit>
+#include <cstring>
+
+namespace core {
+
+static_assert(std::endian::native == std::endian::little, "the asset pack format is little-endian");
+
+static constexpr auto HEADER_SIZE = static_cast<std::int64_t>(sizeof(Asset_Pack_Header));
+static constexpr auto ENTRY_SIZE = static_cast<std::int64_t>(sizeof(Asset_Pack_Entry));
+
+template <typename T> static auto read_at(const uchar *data, std::int64_t offset) -> T
+{
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+Asset_Pack::Asset_Pack(const QString &path)
+    : file_{path}
+    , directory_{QFileInfo{path}.absolutePath()}
+{
+    if (!file_.open(QIODevice::ReadOnly)) return;
+
+    data_size_ = file_.size();
+    if (data_size_ < HEADER_SIZE) return;
+
+    data_ = file_.map(0, data_size_);
+    valid_ = data_ && validate();
+}
+
+Asset_Pack::~Asset_Pack()
+{
+    if (data_) file_.unmap(const_cast<uchar *>(data_));
+}
+
+auto Asset_Pack::application() -> const Asset_Pack &
+{
+    const auto file_name = QString::fromUtf8(ASSET_PACK_FILE_NAME.data(), static_cast<qsizetype>(ASSET_PACK_FILE_NAME.size()));
+    static const auto pack = Asset_Pack{QCoreApplication::applicationDirPath() + "/" + file_name};
+    return pack;
+}
+
+auto Asset_Pack::is_valid() const -> bool
+{
+    return valid_;
+}
+
+auto Asset_Pack::find(std::string_view name) const -> Asset
+{
+    if (!valid_) return read_loose_file(name);
+
+    // the index is sorted by name
+    std::uint32_t low = 0;
+    std::uint32_t high = entry_count_;
+    while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        const auto candidate = entry(middle);
+        const auto candidate_name = name_of(candidate);
+
+        if (candidate_name < name) {
+            low = middle + 1;
+        } else if (name < candidate_name) {
+            high = middle;
+        } else {
+            const auto *bytes = reinterpret_cast<const char *>(data_ + candidate.data_offset);
+            return {.data = QByteArray::fromRawData(bytes, static_cast<qsizetype>(candidate.data_size)), .hash = candidate.hash};
+        }
+    }
+
+    return {};
+}
+
+auto Asset_Pack::validate() -> bool
+{
+    const auto header = read_at<Asset_Pack_Header>(data_, 0);
+    if (header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION) return false;
+
+    names_offset_ = HEADER_SIZE + static_cast<std::int64_t>(header.entry_count) * ENTRY_SIZE;
+    if (names_offset_ + static_cast<std::int64_t>(header.names_size) > data_size_) return false;
+
+    entry_count_ = header.entry_count;
+    for (std::uint32_t i = 0; i < entry_count_; ++i) {
+        const auto e = entry(i);
+        if (static_cast<std::uint64_t>(e.name_offset) + e.name_length > header.names_size) return false;
+        const auto file_size = static_cast<std::uint64_t>(data_size_);
+        if (e.data_offset > file_size || e.data_size > file_size - e.data_offset) return false;
+    }
+
+    return true;
+}
+
+auto Asset_Pack::entry(std::uint32_t index) const -> Asset_Pack_Entry
+{
+    return read_at<Asset_Pack_Entry>(data_, HEADER_SIZE + static_cast<std::int64_t>(index) * ENTRY_SIZE);
+}
+
+auto Asset_Pack::name_of(const Asset_Pack_Entry &entry) const -> std::string_view
+{
+    return {reinterpret_cast<const char *>(data_ + names_offset_ + entry.name_offset), entry.name_length};
+}
+
+auto Asset_Pack::read_loose_file(std::string_view name) const -> Asset
+{
+    auto file = QFile{directory_ + "/" + QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()))};
+    if (!file.open(QIODevice::ReadOnly)) return {};
+
+    auto data = file.readAll();
+    const auto hash = asset_hash(std::string_view{data.constData(), static_cast<std::size_t>(data.size())});
+    return {.data = std::move(data), .hash = hash};
+}
+
+} // namespace core
@@ -0,0 +1,79 @@
+// =================================================================================
+// core/asset_pack.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/asset_pack_format.hpp"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <cstdint>
+#include <string_view>
+
+namespace core {
+
+/// @struct Asset
+/// @brief The content of one asset and its content hash.
+struct Asset {
+    /// @brief Points into the mapped pack without copying; empty if the asset was not found.
+    QByteArray data;
+
+    /// @brief The asset_hash of the content, computed when the pack was built.
+    std::uint64_t hash = 0;
+};
+
+/// @class Asset_Pack
+/// @brief A read-only, memory-mapped archive of the banners and icons.
+///
+/// build.cc packs resources/banners and resources/icons into one file with a sorted
+/// index, so startup opens a single file and every lookup is a binary search. The
+/// returned data refers to the mapping directly and can be handed to QImageReader or
+/// QSvgRenderer as is. Without a valid pack, assets are read as loose files from the
+/// pack's directory instead.
+///
+/// @note Lookups only read the mapping, so they may run on any thread.
+class Asset_Pack final {
+  public:
+    /// @brief Maps a pack file; falls back to loose files next to it if it is missing or invalid.
+    explicit Asset_Pack(const QString &path);
+    ~Asset_Pack();
+
+    Asset_Pack(const Asset_Pack &) = delete;
+    auto operator=(const Asset_Pack &) -> Asset_Pack & = delete;
+
+    /// @brief Returns the pack next to the executable, mapped on first use.
+    static auto application() -> const Asset_Pack &;
+
+    /// @brief Returns true if the pack was mapped and passed all bounds checks.
+    auto is_valid() const -> bool;
+
+    /// @brief Returns an asset by its path relative to resources, e.g. "banners/league.jpg".
+    auto find(std::string_view name) const -> Asset;
+
+  private:
+    /// @brief Checks the header, the index and every data range against the file size.
+    auto validate() -> bool;
+
+    auto entry(std::uint32_t index) const -> Asset_Pack_Entry;
+    auto name_of(const Asset_Pack_Entry &entry) const -> std::string_view;
+
+    /// @brief Reads an asset from the loose file of the same name.
+    auto read_loose_file(std::string_view name) const -> Asset;
+
+  private:
+    QFile file_;
+    const uchar *data_ = nullptr;
+    std::int64_t data_size_ = 0;
+    bool valid_ = false;
+
+    std::uint32_t entry_count_ = 0;
+    std::int64_t names_offset_ = 0;
+
+    /// @brief Where loose files are looked up when the pack is not valid.
+    QString directory_;
+};
+
+} // namespace core
@@ -0,0 +1,56 @@
+// =================================================================================
+// core/asset_pack_format.hpp
+// =================================================================================
+
+#pragma once
+
+// shared with build.cc, which writes the pack; keep this header free of Qt
+
+#include <cstdint>
+#include <string_view>
+
+namespace core {
+
+inline constexpr std::uint32_t ASSET_PACK_MAGIC = 0x4B415046; // "FPAK"
+inline constexpr std::uint32_t ASSET_PACK_VERSION = 1;
+
+/// @brief The name of the pack file next to the executable.
+inline constexpr std::string_view ASSET_PACK_FILE_NAME = "assets.pak";
+
+/// @brief Every asset starts at a multiple of this offset, so mapped data is cache line aligned.
+inline constexpr std::uint64_t ASSET_PACK_ALIGNMENT = 64;
+
+/// @brief The fixed header at the start of an asset pack.
+///
+/// It is followed by entry_count entries sorted by name, the concatenated names
+/// (names_size bytes, not terminated), and the asset data at aligned offsets.
+struct Asset_Pack_Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t entry_count;
+    std::uint32_t names_size;
+};
+static_assert(sizeof(Asset_Pack_Header) == 16);
+
+/// @brief An entry of the index; name_offset is relative to the names, data_offset to the file start.
+struct Asset_Pack_Entry {
+    std::uint32_t name_offset;
+    std::uint32_t name_length;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    std::uint64_t hash;
+};
+static_assert(sizeof(Asset_Pack_Entry) == 32);
+
+/// @brief Hashes asset content (64-bit FNV-1a); stored per entry so readers can key caches without touching the data.
+constexpr auto asset_hash(std::string_view bytes) -> std::uint64_t
+{
+    std::uint64_t hash = 0xCBF29CE484222325;
+    for (const char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+} // namespace core
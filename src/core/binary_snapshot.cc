@@ -0,0 +1,205 @@
+// =================================================================================
+// core/binary_snapshot.cc
+// =================================================================================
+
+#include "binary_snapshot.hpp"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <bit>
+#include <cstring>
+
+namespace core {
+
+static_assert(std::endian::native == std::endian::little, "the snapshot format is little-endian");
+
+static constexpr std::uint32_t SNAPSHOT_MAGIC = 0x41445246; // "FRDA"
+static constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+static constexpr auto FIELD_COUNT = static_cast<std::uint32_t>(Binary_Snapshot::Field::Count);
+
+/// @brief The fixed header at the start of every snapshot file.
+struct Snapshot_Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t account_count;
+    std::uint32_t fields_per_account;
+    std::int64_t source_size;
+    std::int64_t source_modified_ms;
+    std::int64_t sequence;
+    std::uint64_t pool_size;
+};
+static_assert(sizeof(Snapshot_Header) == 48);
+
+/// @brief An entry of the offset table, relative to the start of the string pool.
+struct Snapshot_Field {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+static_assert(sizeof(Snapshot_Field) == 8);
+
+static constexpr auto HEADER_SIZE = static_cast<std::int64_t>(sizeof(Snapshot_Header));
+static constexpr auto FIELD_SIZE = static_cast<std::int64_t>(sizeof(Snapshot_Field));
+static constexpr auto ID_SIZE = static_cast<std::int64_t>(sizeof(Account_Id));
+
+template <typename T> static auto read_at(const uchar *data, std::int64_t offset) -> T
+{
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+auto Snapshot_Source::of(const QString &path) -> Snapshot_Source
+{
+    const auto info = QFileInfo{path};
+    if (!info.exists()) return {};
+
+    return {.size = info.size(), .modified_ms = info.lastModified().toMSecsSinceEpoch()};
+}
+
+Binary_Snapshot::Binary_Snapshot(const QString &path)
+    : file_{path}
+{
+    if (!file_.open(QIODevice::ReadOnly)) return;
+
+    data_size_ = file_.size();
+    if (data_size_ < HEADER_SIZE) return;
+
+    data_ = file_.map(0, data_size_);
+    valid_ = data_ && validate();
+}
+
+Binary_Snapshot::~Binary_Snapshot()
+{
+    if (data_) file_.unmap(const_cast<uchar *>(data_));
+}
+
+auto Binary_Snapshot::path_for(const QString &toml_path) -> QString
+{
+    const auto info = QFileInfo{toml_path};
+    return info.absolutePath() + "/" + info.completeBaseName() + ".bin";
+}
+
+auto Binary_Snapshot::write(const QString &path, const QVector<Account> &accounts, const Snapshot_Source &source, std::int64_t sequence)
+    -> bool
+{
+    QVector<Account_Id> ids;
+    ids.reserve(accounts.size());
+
+    QVector<Snapshot_Field> fields;
+    fields.reserve(accounts.size() * FIELD_COUNT);
+
+    QByteArray pool;
+    auto append_field = [&](const QString &value) {
+        const QByteArray utf8 = value.toUtf8();
+        fields.append({static_cast<std::uint32_t>(pool.size()), static_cast<std::uint32_t>(utf8.size())});
+        pool.append(utf8);
+    };
+
+    for (const auto &account : accounts) {
+        ids.append(account.id);
+        append_field(account.note);
+        append_field(account.username);
+        append_field(account.password);
+    }
+
+    const auto header = Snapshot_Header{
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .account_count = static_cast<std::uint32_t>(accounts.size()),
+        .fields_per_account = FIELD_COUNT,
+        .source_size = source.size,
+        .source_modified_ms = source.modified_ms,
+        .sequence = sequence,
+        .pool_size = static_cast<std::uint64_t>(pool.size()),
+    };
+
+    auto file = QSaveFile{path};
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    file.write(reinterpret_cast<const char *>(&header), HEADER_SIZE);
+    file.write(reinterpret_cast<const char *>(ids.constData()), ids.size() * ID_SIZE);
+    file.write(reinterpret_cast<const char *>(fields.constData()), fields.size() * FIELD_SIZE);
+    file.write(pool);
+
+    return file.commit();
+}
+
+auto Binary_Snapshot::is_valid() const -> bool
+{
+    return valid_;
+}
+
+auto Binary_Snapshot::matches(const Snapshot_Source &source) const -> bool
+{
+    return valid_ && source.size >= 0 && source_ == source;
+}
+
+auto Binary_Snapshot::sequence() const -> std::int64_t
+{
+    return sequence_;
+}
+
+auto Binary_Snapshot::size() const -> int
+{
+    return count_;
+}
+
+auto Binary_Snapshot::id(int index) const -> Account_Id
+{
+    return read_at<Account_Id>(data_, HEADER_SIZE + static_cast<std::int64_t>(index) * ID_SIZE);
+}
+
+auto Binary_Snapshot::field(int index, Field field) const -> QUtf8StringView
+{
+    const auto slot = static_cast<std::int64_t>(index) * FIELD_COUNT + static_cast<std::int64_t>(field);
+    const auto entry = read_at<Snapshot_Field>(data_, fields_offset_ + slot * FIELD_SIZE);
+
+    return QUtf8StringView{reinterpret_cast<const char *>(data_ + pool_offset_ + entry.offset), entry.length};
+}
+
+auto Binary_Snapshot::to_accounts() const -> QVector<Account>
+{
+    QVector<Account> accounts;
+    if (!valid_) return accounts;
+
+    accounts.reserve(count_);
+    for (int i = 0; i < count_; ++i) {
+        Account account;
+        account.id = id(i);
+        account.note = QString::fromUtf8(field(i, Field::Note));
+        account.username = QString::fromUtf8(field(i, Field::Username));
+        account.password = QString::fromUtf8(field(i, Field::Password));
+        accounts.append(std::move(account));
+    }
+
+    return accounts;
+}
+
+auto Binary_Snapshot::validate() -> bool
+{
+    const auto header = read_at<Snapshot_Header>(data_, 0);
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) return false;
+    if (header.fields_per_account != FIELD_COUNT) return false;
+
+    const std::int64_t slot_count = static_cast<std::int64_t>(header.account_count) * FIELD_COUNT;
+    const std::int64_t fields_offset = HEADER_SIZE + static_cast<std::int64_t>(header.account_count) * ID_SIZE;
+    const std::int64_t pool_offset = fields_offset + slot_count * FIELD_SIZE;
+    if (pool_offset > data_size_ || static_cast<std::uint64_t>(data_size_ - pool_offset) != header.pool_size) return false;
+
+    for (std::int64_t slot = 0; slot < slot_count; ++slot) {
+        const auto entry = read_at<Snapshot_Field>(data_, fields_offset + slot * FIELD_SIZE);
+        if (static_cast<std::uint64_t>(entry.offset) + entry.length > header.pool_size) return false;
+    }
+
+    source_ = {.size = header.source_size, .modified_ms = header.source_modified_ms};
+    sequence_ = header.sequence;
+    count_ = static_cast<int>(header.account_count);
+    fields_offset_ = fields_offset;
+    pool_offset_ = pool_offset;
+    return true;
+}
+
+} // namespace core
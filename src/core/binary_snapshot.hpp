@@ -0,0 +1,102 @@
+// =================================================================================
+// core/binary_snapshot.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+
+#include <QFile>
+#include <QString>
+#include <QUtf8StringView>
+#include <QVector>
+
+#include <cstdint>
+
+namespace core {
+
+/// @struct Snapshot_Source
+/// @brief Identifies the exact TOML file a binary snapshot was generated from.
+struct Snapshot_Source {
+    std::int64_t size = -1;
+    std::int64_t modified_ms = 0;
+
+    /// @brief Captures the current size and modification time of a file.
+    static auto of(const QString &path) -> Snapshot_Source;
+
+    auto operator==(const Snapshot_Source &) const -> bool = default;
+};
+
+/// @class Binary_Snapshot
+/// @brief A compact, memory-mapped mirror of the accounts TOML file.
+///
+/// The file consists of a fixed header, a column of account IDs, an offset table with
+/// one (offset, length) pair per account field, and a UTF-8 string pool. Opening it
+/// maps the file read-only, so reading the accounts is a walk over the offset table instead of
+/// a TOML parse. The TOML file stays the source of truth: a snapshot whose recorded
+/// source no longer matches the TOML file is ignored and regenerated.
+///
+/// @note On Windows a mapped file cannot be replaced, so instances should be short-lived.
+class Binary_Snapshot final {
+  public:
+    /// @brief The account fields stored per record, in offset table order.
+    enum class Field : std::uint32_t { Note, Username, Password, Count };
+
+    /// @brief Maps an existing snapshot file; check is_valid() before use.
+    explicit Binary_Snapshot(const QString &path);
+    ~Binary_Snapshot();
+
+    Binary_Snapshot(const Binary_Snapshot &) = delete;
+    auto operator=(const Binary_Snapshot &) -> Binary_Snapshot & = delete;
+
+    /// @brief Returns the path of the binary snapshot belonging to a TOML file.
+    static auto path_for(const QString &toml_path) -> QString;
+
+    /// @brief Writes a snapshot of the given accounts atomically.
+    /// @param path The snapshot file to write.
+    /// @param accounts Every entry of the accounts array, in file order.
+    /// @param source The identity of the TOML file the accounts were read from.
+    /// @param sequence The journal sequence folded into the TOML file.
+    static auto write(const QString &path, const QVector<Account> &accounts, const Snapshot_Source &source, std::int64_t sequence)
+        -> bool;
+
+    /// @brief Returns true if the file was mapped and passed all bounds checks.
+    auto is_valid() const -> bool;
+
+    /// @brief Returns true if the snapshot is valid and was generated from the given source.
+    auto matches(const Snapshot_Source &source) const -> bool;
+
+    /// @brief Returns the journal sequence recorded alongside the accounts.
+    auto sequence() const -> std::int64_t;
+
+    /// @brief Returns the number of accounts in the snapshot.
+    auto size() const -> int;
+
+    /// @brief Returns the ID of the account at a given position.
+    auto id(int index) const -> Account_Id;
+
+    /// @brief Returns a view of one field of one account, pointing into the mapping.
+    auto field(int index, Field field) const -> QUtf8StringView;
+
+    /// @brief Decodes every account in the snapshot into owning values.
+    /// @note Loading walks id() and field() instead; this full decode is only meant for exports and imports.
+    auto to_accounts() const -> QVector<Account>;
+
+  private:
+    /// @brief Checks the header, the offset table and every string range against the file size.
+    auto validate() -> bool;
+
+  private:
+    QFile file_;
+    const uchar *data_ = nullptr;
+    std::int64_t data_size_ = 0;
+    bool valid_ = false;
+
+    Snapshot_Source source_;
+    std::int64_t sequence_ = 0;
+    int count_ = 0;
+    std::int64_t fields_offset_ = 0;
+    std::int64_t pool_offset_ = 0;
+};
+
+} // namespace core
@@ -4,19 +4,39 @@
 
 #include "config.hpp"
 
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QMessageBox>
 #include <QStandardPaths>
 #include <QTextStream>
 
 #include <fstream>
+#include <mutex>
+#include <sstream>
 #include <string_view>
 
 using namespace std::literals;
 
 namespace core {
 
+/// @brief A parsed file along with the identity of the bytes it was parsed from.
+struct Cached_Config {
+    qint64 size = -1;
+    qint64 modified_ms = 0;
+    size_t content_hash = 0;
+    std::shared_ptr<const toml::table> table;
+};
+
+/// @brief Files modified this recently are hashed even if their size and mtime match,
+/// since a second write within the timestamp granularity would otherwise go unnoticed.
+static constexpr qint64 RACY_WINDOW_MS = 2000;
+
+static std::mutex cache_mutex;
+static QHash<QString, Cached_Config> config_cache;
+
 Config::Config(const QString file_name)
     : config_path_{initialize_config_path(file_name)}
 {
@@ -58,35 +78,78 @@ auto Config::initialize_config_path(const QString file_name) -> QString
     return config_file_path;
 }
 
-auto Config::load() const -> toml::table
+auto Config::load_shared() const -> std::shared_ptr<const toml::table>
 {
-    if (config_path_.isEmpty()) return {};
+    static const auto empty_table = std::make_shared<const toml::table>();
+    if (config_path_.isEmpty()) return empty_table;
 
-    auto result = toml::parse_file(config_path_.toStdString());
-    if (!result) {
-        if (std::string_view{result.error().description()}.find("The file was empty"sv) != std::string_view::npos) { return {}; }
+    const auto info = QFileInfo{config_path_};
+    const auto size = info.size();
+    const auto modified_ms = info.lastModified().toMSecsSinceEpoch();
+    const bool racy = QDateTime::currentMSecsSinceEpoch() - modified_ms < RACY_WINDOW_MS;
 
-        const auto message =
-            QString{"Failed to parse configuration.toml:\n"} + QString::fromStdString(std::string{result.error().description()});
-        QMessageBox::critical(nullptr, "Config Error", message);
-        return {};
+    auto lock = std::unique_lock{cache_mutex};
+
+    auto cached = config_cache.find(config_path_);
+    const bool known = cached != config_cache.end();
+    if (known && !racy && cached->size == size && cached->modified_ms == modified_ms) return cached->table;
+
+    auto file = QFile{config_path_};
+    if (!file.open(QIODevice::ReadOnly)) return empty_table;
+
+    const QByteArray bytes = file.readAll();
+    const size_t content_hash = qHash(bytes);
+
+    // touched but not changed, e.g. rewritten with the same contents
+    if (known && cached->content_hash == content_hash && cached->size == bytes.size()) {
+        cached->size = size;
+        cached->modified_ms = modified_ms;
+        return cached->table;
     }
 
-    return std::move(result).table();
+    auto table = empty_table;
+    if (!bytes.isEmpty()) {
+        const auto document = std::string_view{bytes.constData(), static_cast<size_t>(bytes.size())};
+        auto result = toml::parse(document, config_path_.toStdString());
+        if (!result) {
+            // the message box spins an event loop that may load configs itself
+            lock.unlock();
+
+            const auto message =
+                QString{"Failed to parse configuration.toml:\n"} + QString::fromStdString(std::string{result.error().description()});
+            QMessageBox::critical(nullptr, "Config Error", message);
+            return empty_table;
+        }
+
+        table = std::make_shared<const toml::table>(std::move(result).table());
+    }
+
+    config_cache.insert(config_path_, {.size = size, .modified_ms = modified_ms, .content_hash = content_hash, .table = table});
+    return table;
+}
+
+auto Config::load() const -> toml::table
+{
+    return *load_shared();
 }
 
 auto Config::save(const toml::table &config) -> bool
 {
     if (config_path_.isEmpty()) return false;
 
+    std::string bytes;
     try {
-        auto ofs = std::ofstream{config_path_.toStdString()};
+        auto stream = std::ostringstream{};
+        stream << config;
+        bytes = std::move(stream).str();
+
+        auto ofs = std::ofstream{config_path_.toStdString(), std::ios::binary};
         if (!ofs.is_open()) {
             QMessageBox::critical(nullptr, "Save Error", "Failed to open config for writing.");
             return false;
         }
 
-        ofs << config;
+        ofs << bytes;
         ofs.close();
 
     } catch (const std::exception &e) {
@@ -94,6 +157,15 @@ auto Config::save(const toml::table &config) -> bool
         return false;
     }
 
+    // the next load only has to stat the file to find that this is still current
+    const auto info = QFileInfo{config_path_};
+    const auto content_hash = qHash(QByteArray::fromRawData(bytes.data(), static_cast<qsizetype>(bytes.size())));
+
+    const auto lock = std::scoped_lock{cache_mutex};
+    config_cache.insert(config_path_, {.size = info.size(),
+                                       .modified_ms = info.lastModified().toMSecsSinceEpoch(),
+                                       .content_hash = content_hash,
+                                       .table = std::make_shared<const toml::table>(config)});
     return true;
 }
 
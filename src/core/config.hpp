@@ -6,6 +6,8 @@
 
 #include <QString>
 
+#include <memory>
+
 #define TOML_EXCEPTIONS 0
 #define TOML_HEADER_ONLY 1
 #include <toml++/toml.hpp>
@@ -14,6 +16,10 @@ namespace core {
 
 /// @class Config
 /// @brief Base class for managing TOML configuration files.
+///
+/// Parsed files are kept in a process-wide cache keyed on the file's path, size,
+/// modification time and content hash. Loading a file that has not changed costs a
+/// stat call, and every reader shares the same immutable table.
 class Config {
   public:
     virtual ~Config() = default;
@@ -29,10 +35,13 @@ class Config {
     /// @param file_name The name of the configuration file (e.g., "theme.toml").
     explicit Config(const QString file_name);
 
-    /// @brief Reads the TOML file from disk into a toml::table.
+    /// @brief Returns the parsed TOML file, only reading the disk if the file changed.
+    auto load_shared() const -> std::shared_ptr<const toml::table>;
+
+    /// @brief Returns a mutable copy of the parsed TOML file.
     auto load() const -> toml::table;
 
-    /// @brief Writes a toml::table to the configuration file on disk.
+    /// @brief Writes a toml::table to the configuration file on disk and caches it.
     auto save(const toml::table &config) -> bool;
 
   private:
@@ -0,0 +1,136 @@
+// =================================================================================
+// core/stylesheet_template.cc
+// =================================================================================
+
+#include "stylesheet_template.hpp"
+
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+
+#include <array>
+#include <utility>
+
+namespace core {
+
+namespace {
+
+/// @brief Every color renders as "#rrggbb".
+constexpr qsizetype COLOR_NAME_SIZE = 7;
+
+struct Slot_Binding {
+    QStringView name;
+    QColor Theme::*member;
+};
+
+constexpr auto SLOT_BINDINGS = std::array{
+    Slot_Binding{u"background_super_dark", &Theme::background_super_dark},
+    Slot_Binding{u"background_dark", &Theme::background_dark},
+    Slot_Binding{u"background_light", &Theme::background_light},
+    Slot_Binding{u"text_primary", &Theme::text_primary},
+    Slot_Binding{u"text_secondary", &Theme::text_secondary},
+    Slot_Binding{u"border", &Theme::border},
+    Slot_Binding{u"accent", &Theme::accent},
+    Slot_Binding{u"accent_hover", &Theme::accent_hover},
+    Slot_Binding{u"button_primary", &Theme::button_primary},
+    Slot_Binding{u"button_hover", &Theme::button_hover},
+    Slot_Binding{u"button_disabled", &Theme::button_disabled},
+    Slot_Binding{u"text_disabled", &Theme::text_disabled},
+    Slot_Binding{u"success", &Theme::success},
+    Slot_Binding{u"error", &Theme::error},
+};
+
+auto find_slot(QStringView name) -> QColor Theme::*
+{
+    for (const auto &binding : SLOT_BINDINGS) {
+        if (binding.name == name) return binding.member;
+    }
+    return nullptr;
+}
+
+/// @brief The first line of a cache file; the rest of the file is the stylesheet.
+auto cache_header(std::size_t key) -> QByteArray
+{
+    return "/* stylesheet " + QByteArray::number(static_cast<qulonglong>(key), 16) + " */\n";
+}
+
+} // namespace
+
+auto theme_hash(const Theme &theme) -> std::size_t
+{
+    std::array<QRgb, SLOT_BINDINGS.size()> colors;
+    for (std::size_t i = 0; i < SLOT_BINDINGS.size(); ++i) colors[i] = (theme.*SLOT_BINDINGS[i].member).rgba();
+    return qHashBits(colors.data(), sizeof(colors));
+}
+
+Stylesheet_Template::Stylesheet_Template(QString source)
+    : source_{std::move(source)}
+{
+    qsizetype literal_start = 0;
+    qsizetype pos = 0;
+
+    while ((pos = source_.indexOf(u"${", pos)) != -1) {
+        const auto close = source_.indexOf(u'}', pos + 2);
+        if (close == -1) break;
+
+        const auto slot = find_slot(QStringView{source_}.sliced(pos + 2, close - pos - 2));
+        if (!slot) {
+            pos = close + 1;
+            continue;
+        }
+
+        segments_.append(Segment{literal_start, pos - literal_start, slot});
+        rendered_size_ += pos - literal_start + COLOR_NAME_SIZE;
+        literal_start = pos = close + 1;
+    }
+
+    segments_.append(Segment{literal_start, source_.size() - literal_start, nullptr});
+    rendered_size_ += source_.size() - literal_start;
+}
+
+auto Stylesheet_Template::fields() const -> QVector<QColor Theme::*>
+{
+    QVector<QColor Theme::*> fields;
+    for (const auto &segment : segments_) {
+        if (segment.slot && !fields.contains(segment.slot)) fields.append(segment.slot);
+    }
+    return fields;
+}
+
+auto Stylesheet_Template::render(const Theme &theme) const -> QString
+{
+    QString result;
+    result.reserve(rendered_size_);
+
+    for (const auto &segment : segments_) {
+        result.append(QStringView{source_}.sliced(segment.offset, segment.length));
+        if (segment.slot) result.append((theme.*segment.slot).name());
+    }
+
+    return result;
+}
+
+auto Stylesheet_Template::render_cached(const Theme &theme, const QString &cache_path) const -> QString
+{
+    const auto header = cache_header(qHash(source_, theme_hash(theme)));
+
+    auto file = QFile{cache_path};
+    if (file.open(QIODevice::ReadOnly)) {
+        const auto bytes = file.readAll();
+        if (bytes.startsWith(header)) return QString::fromUtf8(QByteArrayView{bytes}.sliced(header.size()));
+        file.close();
+    }
+
+    const auto stylesheet = render(theme);
+
+    auto cache = QSaveFile{cache_path};
+    if (cache.open(QIODevice::WriteOnly)) {
+        cache.write(header);
+        cache.write(stylesheet.toUtf8());
+        cache.commit();
+    }
+
+    return stylesheet;
+}
+
+} // namespace core
@@ -0,0 +1,59 @@
+// =================================================================================
+// core/stylesheet_template.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/theme.hpp"
+
+#include <QString>
+#include <QStringView>
+#include <QVector>
+
+#include <cstddef>
+
+namespace core {
+
+/// @brief Returns a hash over every color of a theme, used to key rendered stylesheets.
+auto theme_hash(const Theme &theme) -> std::size_t;
+
+/// @class Stylesheet_Template
+/// @brief A QSS template with named ${field} slots bound to the colors of a Theme.
+///
+/// The source is split once into literal segments and slots, so rendering is a
+/// single pass of appends into a preallocated string. Slot names are the Theme member
+/// names (e.g. ${background_dark}); unknown names are kept as literal text.
+class Stylesheet_Template final {
+  public:
+    /// @brief Compiles a template.
+    explicit Stylesheet_Template(QString source);
+
+    /// @brief Returns the distinct theme fields referenced by the slots, in order of first use.
+    auto fields() const -> QVector<QColor Theme::*>;
+
+    /// @brief Fills every slot with the matching theme color.
+    auto render(const Theme &theme) const -> QString;
+
+    /// @brief Returns the stylesheet for a theme from a cache file, rendering and storing it on a miss.
+    ///
+    /// The file is keyed on the template and the theme hash, so a changed theme or a
+    /// changed template simply misses. Failing to write the cache is not an error.
+    auto render_cached(const Theme &theme, const QString &cache_path) const -> QString;
+
+  private:
+    /// @brief A run of literal source text followed by an optional slot.
+    struct Segment {
+        qsizetype offset;
+        qsizetype length;
+        QColor Theme::*slot;
+    };
+
+  private:
+    QString source_;
+    QVector<Segment> segments_;
+
+    /// @brief The number of characters in a render, with every slot expanded.
+    qsizetype rendered_size_ = 0;
+};
+
+} // namespace core
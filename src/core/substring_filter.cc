@@ -0,0 +1,202 @@
+// =================================================================================
+// core/substring_filter.cc
+// =================================================================================
+
+#include "substring_filter.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SUBSTRING_FILTER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define SUBSTRING_FILTER_X86 0
+#endif
+
+// MSVC accepts AVX2 intrinsics in any function, GCC and Clang only in ones targeting it
+#if SUBSTRING_FILTER_X86 && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace core {
+
+namespace {
+
+/// @brief Returns the position of the first match, or std::string_view::npos.
+using Kernel = std::size_t (*)(std::string_view haystack, std::string_view needle);
+
+constexpr auto NPOS = std::string_view::npos;
+
+auto ascii_lower(char c) -> char
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+auto ascii_upper(char c) -> char
+{
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+/// @brief Compares text against an already lowered needle.
+auto equals_lowered(const char *text, const char *needle, std::size_t length) -> bool
+{
+    for (std::size_t i = 0; i < length; ++i) {
+        if (ascii_lower(text[i]) != needle[i]) return false;
+    }
+    return true;
+}
+
+/// @brief Adds a block offset to a position found in the rest of the haystack.
+auto offset_by(std::size_t position, std::size_t offset) -> std::size_t
+{
+    return position == NPOS ? NPOS : position + offset;
+}
+
+auto find_scalar(std::string_view haystack, std::string_view needle) -> std::size_t
+{
+    if (needle.size() > haystack.size()) return NPOS;
+
+    const char first = needle.front();
+    for (std::size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+        if (ascii_lower(haystack[i]) != first) continue;
+        if (equals_lowered(haystack.data() + i + 1, needle.data() + 1, needle.size() - 1)) return i;
+    }
+    return NPOS;
+}
+
+#if SUBSTRING_FILTER_X86
+
+auto find_sse2(std::string_view haystack, std::string_view needle) -> std::size_t
+{
+    if (needle.size() > haystack.size()) return NPOS;
+
+    const std::size_t last = needle.size() - 1;
+    const __m128i first_lower = _mm_set1_epi8(needle.front());
+    const __m128i first_upper = _mm_set1_epi8(ascii_upper(needle.front()));
+    const __m128i last_lower = _mm_set1_epi8(needle.back());
+    const __m128i last_upper = _mm_set1_epi8(ascii_upper(needle.back()));
+
+    const char *data = haystack.data();
+    std::size_t i = 0;
+    for (; i + last + 16 <= haystack.size(); i += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + last));
+
+        const __m128i eq_first = _mm_or_si128(_mm_cmpeq_epi8(block_first, first_lower), _mm_cmpeq_epi8(block_first, first_upper));
+        const __m128i eq_last = _mm_or_si128(_mm_cmpeq_epi8(block_last, last_lower), _mm_cmpeq_epi8(block_last, last_upper));
+
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+        while (mask != 0) {
+            const auto offset = static_cast<std::size_t>(std::countr_zero(mask));
+            if (equals_lowered(data + i + offset + 1, needle.data() + 1, last)) return i + offset;
+            mask &= mask - 1;
+        }
+    }
+
+    return offset_by(find_scalar(haystack.substr(i), needle), i);
+}
+
+TARGET_AVX2 auto find_avx2(std::string_view haystack, std::string_view needle) -> std::size_t
+{
+    if (needle.size() > haystack.size()) return NPOS;
+
+    const std::size_t last = needle.size() - 1;
+    const __m256i first_lower = _mm256_set1_epi8(needle.front());
+    const __m256i first_upper = _mm256_set1_epi8(ascii_upper(needle.front()));
+    const __m256i last_lower = _mm256_set1_epi8(needle.back());
+    const __m256i last_upper = _mm256_set1_epi8(ascii_upper(needle.back()));
+
+    const char *data = haystack.data();
+    std::size_t i = 0;
+    for (; i + last + 32 <= haystack.size(); i += 32) {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + last));
+
+        const __m256i eq_first =
+            _mm256_or_si256(_mm256_cmpeq_epi8(block_first, first_lower), _mm256_cmpeq_epi8(block_first, first_upper));
+        const __m256i eq_last = _mm256_or_si256(_mm256_cmpeq_epi8(block_last, last_lower), _mm256_cmpeq_epi8(block_last, last_upper));
+
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)));
+        while (mask != 0) {
+            const auto offset = static_cast<std::size_t>(std::countr_zero(mask));
+            if (equals_lowered(data + i + offset + 1, needle.data() + 1, last)) return i + offset;
+            mask &= mask - 1;
+        }
+    }
+
+    // the remainder is shorter than a 256-bit block, but may still fill a 128-bit one
+    return offset_by(find_sse2(haystack.substr(i), needle), i);
+}
+
+/// @brief Returns true if the CPU supports AVX2 and the OS saves the YMM registers.
+auto cpu_has_avx2() -> bool
+{
+#if defined(_MSC_VER)
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+
+    __cpuid(regs, 1);
+    const bool os_saves_ymm = (regs[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+    __cpuidex(regs, 7, 0);
+    return os_saves_ymm && (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+auto select_kernel() -> Kernel
+{
+#if SUBSTRING_FILTER_X86
+    return cpu_has_avx2() ? find_avx2 : find_sse2;
+#else
+    return find_scalar;
+#endif
+}
+
+const Kernel KERNEL = select_kernel();
+
+} // namespace
+
+Substring_Filter::Substring_Filter(std::string_view needle)
+{
+    needle_.reserve(needle.size());
+    for (const char c : needle) needle_.push_back(ascii_lower(c));
+}
+
+auto Substring_Filter::size() const -> std::size_t
+{
+    return needle_.size();
+}
+
+auto Substring_Filter::find(std::string_view haystack, std::size_t from) const -> std::size_t
+{
+    if (from > haystack.size()) return NPOS;
+    if (needle_.empty()) return from;
+    return offset_by(KERNEL(haystack.substr(from), needle_), from);
+}
+
+auto Substring_Filter::matches(std::string_view haystack) const -> bool
+{
+    return find(haystack, 0) != NPOS;
+}
+
+auto Substring_Filter::matches(QUtf8StringView haystack) const -> bool
+{
+    return matches(std::string_view{reinterpret_cast<const char *>(haystack.data()), static_cast<std::size_t>(haystack.size())});
+}
+
+} // namespace core
@@ -0,0 +1,45 @@
+// =================================================================================
+// core/substring_filter.hpp
+// =================================================================================
+
+#pragma once
+
+#include <QUtf8StringView>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace core {
+
+/// @class Substring_Filter
+/// @brief A brute-force, ASCII case-insensitive substring matcher for UTF-8 text.
+///
+/// Candidate positions are found by comparing the first and last byte of the needle
+/// against 16 (SSE2) or 32 (AVX2) positions of the haystack at once, and only those
+/// candidates are verified byte by byte. The widest kernel the CPU supports is chosen
+/// once at startup, with a scalar fallback on other architectures. Bytes outside of
+/// ASCII are compared exactly.
+class Substring_Filter final {
+  public:
+    /// @brief Prepares a filter for a needle; an empty needle matches everything.
+    explicit Substring_Filter(std::string_view needle);
+
+    /// @brief Returns the length of the needle in bytes.
+    auto size() const -> std::size_t;
+
+    /// @brief Returns the position of the first match at or after from, or std::string_view::npos.
+    auto find(std::string_view haystack, std::size_t from) const -> std::size_t;
+
+    /// @brief Returns true if the haystack contains the needle.
+    auto matches(std::string_view haystack) const -> bool;
+
+    /// @copydoc matches
+    auto matches(QUtf8StringView haystack) const -> bool;
+
+  private:
+    /// @brief The needle with ASCII letters lowered.
+    std::string needle_;
+};
+
+} // namespace core
@@ -13,11 +13,11 @@ Theme_Config::Theme_Config()
 
 auto Theme_Config::load() const -> Theme
 {
-    const auto config = Config::load();
+    const auto config = Config::load_shared();
     Theme theme;
 
     auto get_color_or_default = [&](const char *key, const char *default_hex) {
-        auto value = config[key].value<std::string>();
+        auto value = (*config)[key].value<std::string>();
         return value ? QColor(QString::fromStdString(*value)) : QColor(default_hex);
     };
 
@@ -0,0 +1,55 @@
+// =================================================================================
+// core/theme_service.cc
+// =================================================================================
+
+#include "theme_service.hpp"
+
+namespace core {
+
+Theme_Service::Theme_Service(Theme_Config *config, QObject *parent)
+    : QObject{parent}
+    , config_{config}
+    , theme_{std::make_shared<const Theme>(config->load())}
+    , saved_{theme_}
+{
+}
+
+auto Theme_Service::theme() const -> const Theme &
+{
+    return *theme_;
+}
+
+auto Theme_Service::snapshot() const -> std::shared_ptr<const Theme>
+{
+    return theme_;
+}
+
+auto Theme_Service::save(const Theme &theme) -> bool
+{
+    if (!config_->save(theme)) return false;
+
+    theme_ = saved_ = std::make_shared<const Theme>(theme);
+    emit theme_changed();
+    return true;
+}
+
+auto Theme_Service::preview(const Theme &theme) -> void
+{
+    theme_ = std::make_shared<const Theme>(theme);
+    emit theme_changed();
+}
+
+auto Theme_Service::revert() -> void
+{
+    if (!is_previewing()) return;
+
+    theme_ = saved_;
+    emit theme_changed();
+}
+
+auto Theme_Service::is_previewing() const -> bool
+{
+    return theme_ != saved_;
+}
+
+} // namespace core
@@ -0,0 +1,63 @@
+// =================================================================================
+// core/theme_service.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/theme.hpp"
+
+#include <QObject>
+
+#include <memory>
+
+namespace core {
+
+/// @class Theme_Service
+/// @brief Holds the current theme in memory and announces when it changes.
+///
+/// The theme file is read once on construction; afterwards every reader gets the
+/// same immutable snapshot, so paint and resize paths never touch the disk. Saving
+/// replaces the snapshot and emits theme_changed(). A theme can also be previewed,
+/// which makes it current without writing it, until it is saved or reverted.
+class Theme_Service final : public QObject {
+    Q_OBJECT
+
+  public:
+    /// @brief Constructs the service and loads the theme from the configuration.
+    /// @param config The theme configuration used as the backing file.
+    /// @param parent The parent QObject.
+    explicit Theme_Service(Theme_Config *config, QObject *parent = nullptr);
+
+    /// @brief Returns the current theme.
+    /// @note The reference stays valid until the next save; hold on to snapshot() for longer.
+    auto theme() const -> const Theme &;
+
+    /// @brief Returns the current theme as a shared snapshot that never changes.
+    auto snapshot() const -> std::shared_ptr<const Theme>;
+
+    /// @brief Writes a theme to the configuration file and makes it current.
+    /// @return False if the file could not be written; the current theme is kept then.
+    auto save(const Theme &theme) -> bool;
+
+    /// @brief Makes a theme current without writing it to the configuration file.
+    auto preview(const Theme &theme) -> void;
+
+    /// @brief Drops a preview and restores the last saved theme.
+    auto revert() -> void;
+
+    /// @brief Returns whether the current theme is an unsaved preview.
+    auto is_previewing() const -> bool;
+
+  signals:
+    /// @brief Emitted after the current theme was replaced.
+    auto theme_changed() -> void;
+
+  private:
+    Theme_Config *config_;
+    std::shared_ptr<const Theme> theme_;
+
+    /// @brief The theme as last loaded or saved; the same object as theme_ unless previewing.
+    std::shared_ptr<const Theme> saved_;
+};
+
+} // namespace core
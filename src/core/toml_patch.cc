@@ -0,0 +1,87 @@
+// =================================================================================
+// core/toml_patch.cc
+// =================================================================================
+
+#include "toml_patch.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace core {
+
+Toml_Patch::Toml_Patch(std::string_view document)
+    : document_{document}
+{
+    line_starts_.push_back(0);
+    for (std::size_t i = 0; i < document_.size(); ++i) {
+        if (document_[i] == '\n') line_starts_.push_back(i + 1);
+    }
+}
+
+auto Toml_Patch::replace(const toml::node &node, std::string_view value) -> bool
+{
+    auto stream = std::ostringstream{};
+    stream << toml::value<std::string>{std::string{value}};
+    return replace_region(node, std::move(stream).str());
+}
+
+auto Toml_Patch::replace(const toml::node &node, std::int64_t value) -> bool
+{
+    return replace_region(node, std::to_string(value));
+}
+
+auto Toml_Patch::insert(std::size_t offset, std::string text) -> void
+{
+    edits_.push_back({.begin = offset, .end = offset, .text = std::move(text)});
+}
+
+auto Toml_Patch::apply() const -> std::optional<std::string>
+{
+    auto edits = edits_;
+    std::ranges::sort(edits, {}, &Edit::begin);
+
+    std::string patched;
+    patched.reserve(document_.size());
+
+    std::size_t cursor = 0;
+    for (const auto &edit : edits) {
+        if (edit.begin < cursor || edit.end > document_.size()) return std::nullopt;
+
+        patched.append(document_.substr(cursor, edit.begin - cursor));
+        patched.append(edit.text);
+        cursor = edit.end;
+    }
+
+    patched.append(document_.substr(cursor));
+    return patched;
+}
+
+auto Toml_Patch::byte_offset(const toml::source_position &position) const -> std::optional<std::size_t>
+{
+    if (position.line == 0 || position.column == 0 || position.line > line_starts_.size()) return std::nullopt;
+
+    // toml++ counts columns in codepoints, so walk the line skipping UTF-8 continuation bytes
+    auto offset = line_starts_[position.line - 1];
+    for (toml::source_index column = 1; column < position.column; ++column) {
+        if (offset >= document_.size()) return std::nullopt;
+
+        ++offset;
+        while (offset < document_.size() && (static_cast<unsigned char>(document_[offset]) & 0xC0) == 0x80) ++offset;
+    }
+
+    return offset;
+}
+
+auto Toml_Patch::replace_region(const toml::node &node, std::string formatted) -> bool
+{
+    const auto &region = node.source();
+
+    const auto begin = byte_offset(region.begin);
+    const auto end = byte_offset(region.end);
+    if (!begin || !end || *end < *begin) return false;
+
+    edits_.push_back({.begin = *begin, .end = *end, .text = std::move(formatted)});
+    return true;
+}
+
+} // namespace core
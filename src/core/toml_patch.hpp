@@ -0,0 +1,65 @@
+// =================================================================================
+// core/toml_patch.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/config.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+/// @class Toml_Patch
+/// @brief Rewrites individual values of a TOML document in place.
+///
+/// toml++ records the source region of every node it parses. A patch collects
+/// replacements for those regions and splices them into the original text, so
+/// everything outside the edited values (formatting, comments, key order) is
+/// kept byte for byte and no re-serialization of the document is needed.
+class Toml_Patch final {
+  public:
+    /// @brief Creates a patch against a document.
+    /// @param document The exact text the nodes were parsed from; it must outlive the patch.
+    explicit Toml_Patch(std::string_view document);
+
+    /// @brief Replaces the value of a node with a string value.
+    /// @return False if the node has no usable source region.
+    auto replace(const toml::node &node, std::string_view value) -> bool;
+
+    /// @brief Replaces the value of a node with an integer value.
+    /// @return False if the node has no usable source region.
+    auto replace(const toml::node &node, std::int64_t value) -> bool;
+
+    /// @brief Inserts raw TOML text at a byte offset.
+    auto insert(std::size_t offset, std::string text) -> void;
+
+    /// @brief Splices every replacement into a copy of the document.
+    /// @return The patched document, or nothing if two edits overlap.
+    auto apply() const -> std::optional<std::string>;
+
+  private:
+    /// @brief Converts a 1-based line and codepoint column into a byte offset.
+    auto byte_offset(const toml::source_position &position) const -> std::optional<std::size_t>;
+
+    /// @brief Replaces a node's source region with already formatted TOML.
+    auto replace_region(const toml::node &node, std::string formatted) -> bool;
+
+  private:
+    /// @struct Edit
+    /// @brief A replacement of the byte range [begin, end).
+    struct Edit {
+        std::size_t begin;
+        std::size_t end;
+        std::string text;
+    };
+
+    std::string_view document_;
+    std::vector<std::size_t> line_starts_;
+    std::vector<Edit> edits_;
+};
+
+} // namespace core
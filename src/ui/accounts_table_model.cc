@@ -0,0 +1,281 @@
+// =================================================================================
+// ui/accounts_table_model.cc
+// =================================================================================
+
+#include "ui/accounts_table_model.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <utility>
+
+namespace ui {
+
+using Field = core::Account_Columns::Field;
+
+/// @brief Shown in place of every password.
+static constexpr auto PASSWORD_MASK = "************";
+
+Accounts_Table_Model::Accounts_Table_Model(core::Account_Store *store, QObject *parent)
+    : QAbstractTableModel{parent}
+    , store_{store}
+    , store_rows_{store->size()}
+{
+    QObject::connect(store_, &core::Account_Store::accounts_inserted, this, &Accounts_Table_Model::on_accounts_inserted);
+    QObject::connect(store_, &core::Account_Store::accounts_removed, this, &Accounts_Table_Model::on_accounts_removed);
+    QObject::connect(store_, &core::Account_Store::accounts_changed, this, &Accounts_Table_Model::on_accounts_changed);
+}
+
+auto Accounts_Table_Model::rowCount(const QModelIndex &parent) const -> int
+{
+    if (parent.isValid()) return 0;
+    return follows_store_ ? store_rows_ : static_cast<int>(rows_.size());
+}
+
+auto Accounts_Table_Model::columnCount(const QModelIndex &parent) const -> int
+{
+    return parent.isValid() ? 0 : Column_Count;
+}
+
+auto Accounts_Table_Model::data(const QModelIndex &index, int role) const -> QVariant
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole)) return {};
+
+    const auto position = follows_store_ ? index.row() : store_->index_of(rows_[index.row()]);
+    if (position < 0 || position >= store_->size()) return {};
+
+    if (index.column() == Password && role == Qt::DisplayRole) return QString{PASSWORD_MASK};
+    return store_->accounts().field(position, static_cast<Field>(index.column())).toString();
+}
+
+auto Accounts_Table_Model::headerData(int section, Qt::Orientation orientation, int role) const -> QVariant
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case Note: return QString{"Note"};
+    case Username: return QString{"Username"};
+    case Password: return QString{"Password"};
+    default: return {};
+    }
+}
+
+auto Accounts_Table_Model::flags(const QModelIndex &index) const -> Qt::ItemFlags
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+auto Accounts_Table_Model::setData(const QModelIndex &index, const QVariant &value, int role) -> bool
+{
+    if (!index.isValid() || role != Qt::EditRole) return false;
+
+    const auto id = id_at(index.row());
+    const auto account = store_->find(id);
+    if (!account) return false;
+
+    auto updated_account = account->to_account();
+    const auto new_value = value.toString();
+    switch (index.column()) {
+    case Note: updated_account.note = new_value; break;
+    case Username: updated_account.username = new_value; break;
+    case Password: updated_account.password = new_value; break;
+    default: return false;
+    }
+
+    // the store's change signal repaints the row
+    if (!store_->update(id, updated_account)) {
+        emit update_failed();
+        return false;
+    }
+    return true;
+}
+
+auto Accounts_Table_Model::sort(int column, Qt::SortOrder order) -> void
+{
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    // remember which account every persistent index (selection, current cell) points at
+    const auto persistent = persistentIndexList();
+    QVector<core::Account_Id> persistent_ids;
+    persistent_ids.reserve(persistent.size());
+    for (const auto &index : persistent) persistent_ids.append(id_at(index.row()));
+
+    sort_column_ = column;
+    sort_order_ = order;
+    rebuild_rows();
+
+    QModelIndexList moved;
+    moved.reserve(persistent.size());
+    for (int i = 0; i < persistent.size(); ++i) {
+        const auto row = row_of(persistent_ids[i]);
+        moved.append(row < 0 ? QModelIndex{} : index(row, persistent[i].column()));
+    }
+    changePersistentIndexList(persistent, moved);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+auto Accounts_Table_Model::set_query(const QString &query) -> void
+{
+    beginResetModel();
+    query_ = query.trimmed();
+    rebuild_rows();
+    endResetModel();
+}
+
+auto Accounts_Table_Model::id_at(int row) const -> core::Account_Id
+{
+    if (row < 0 || row >= rowCount()) return 0;
+    return follows_store_ ? store_->at(row).id : rows_[row];
+}
+
+auto Accounts_Table_Model::row_of(core::Account_Id id) const -> int
+{
+    if (follows_store_) return store_->index_of(id);
+    return row_by_id_.value(id, -1);
+}
+
+auto Accounts_Table_Model::on_accounts_inserted(int first, int last) -> void
+{
+    if (follows_store_) {
+        beginInsertRows({}, first, last);
+        store_rows_ = last + 1;
+        endInsertRows();
+        return;
+    }
+
+    // a batch could land anywhere in a sorted or searched view; one reset beats many single inserts
+    if (first != last) {
+        reload();
+        return;
+    }
+
+    const auto id = store_->accounts().id(first);
+    int row = static_cast<int>(rows_.size());
+    if (!query_.isEmpty()) {
+        // a new account is only shown if it matches, and goes after the ranked results
+        if (!store_->search(query_).contains(id)) return;
+    } else {
+        const auto it = std::upper_bound(rows_.cbegin(), rows_.cend(), first, [this](int position, core::Account_Id row_id) {
+            return sorts_before(position, store_->index_of(row_id));
+        });
+        row = static_cast<int>(it - rows_.cbegin());
+    }
+
+    beginInsertRows({}, row, row);
+    rows_.insert(row, id);
+    renumber_rows(row);
+    endInsertRows();
+}
+
+auto Accounts_Table_Model::on_accounts_removed(int first, int last, const QVector<core::Account_Id> &ids) -> void
+{
+    if (follows_store_) {
+        beginRemoveRows({}, first, last);
+        store_rows_ -= last - first + 1;
+        endRemoveRows();
+        return;
+    }
+
+    QVector<int> removed_rows;
+    removed_rows.reserve(ids.size());
+    for (const auto id : ids) {
+        if (const auto row = row_by_id_.value(id, -1); row >= 0) removed_rows.append(row);
+    }
+    std::ranges::sort(removed_rows);
+
+    // drop every run of adjacent rows at once, back to front so the rows before it stay put
+    for (auto end = removed_rows.size(); end > 0;) {
+        auto begin = end - 1;
+        while (begin > 0 && removed_rows[begin - 1] == removed_rows[begin] - 1) --begin;
+
+        const auto first_row = removed_rows[begin];
+        const auto count = static_cast<int>(end - begin);
+
+        beginRemoveRows({}, first_row, first_row + count - 1);
+        for (int row = first_row; row < first_row + count; ++row) row_by_id_.remove(rows_[row]);
+        rows_.remove(first_row, count);
+        renumber_rows(first_row);
+        endRemoveRows();
+        end = begin;
+    }
+}
+
+auto Accounts_Table_Model::on_accounts_changed(int first, int last, const QVector<core::Account_Id> &ids) -> void
+{
+    if (follows_store_) {
+        emit dataChanged(index(first, 0), index(last, Column_Count - 1), {Qt::DisplayRole, Qt::EditRole});
+        return;
+    }
+
+    for (const auto id : ids) {
+        const auto row = row_by_id_.value(id, -1);
+        if (row >= 0) emit dataChanged(index(row, 0), index(row, Column_Count - 1), {Qt::DisplayRole, Qt::EditRole});
+    }
+}
+
+auto Accounts_Table_Model::renumber_rows(int from) -> void
+{
+    for (auto row = from; row < rows_.size(); ++row) row_by_id_[rows_[row]] = row;
+}
+
+auto Accounts_Table_Model::reload() -> void
+{
+    beginResetModel();
+    rebuild_rows();
+    endResetModel();
+}
+
+auto Accounts_Table_Model::rebuild_rows() -> void
+{
+    row_by_id_.clear();
+
+    // search results keep their ranking; the sort only applies to the full list
+    if (!query_.isEmpty()) {
+        rows_ = store_->search(query_);
+    } else if (sort_column_ < 0 || sort_column_ >= Column_Count) {
+        rows_ = {};
+        follows_store_ = true;
+        store_rows_ = store_->size();
+        return;
+    } else {
+        QVector<int> positions(store_->size());
+        std::iota(positions.begin(), positions.end(), 0);
+        rows_ = sorted_ids(std::move(positions));
+    }
+
+    follows_store_ = false;
+    row_by_id_.reserve(rows_.size());
+    renumber_rows(0);
+}
+
+auto Accounts_Table_Model::sorts_before(int a, int b) const -> bool
+{
+    const auto field = static_cast<Field>(sort_column_);
+
+    // passwords are all shown as the same mask, so sorting by them keeps the store order
+    if (field == Field::Password) return false;
+
+    // UTF-8 byte order is code point order, so the arenas are compared without decoding
+    const auto bytes = [this, field](int position) {
+        const auto value = store_->accounts().field(position, field);
+        return std::string_view{reinterpret_cast<const char *>(value.data()), static_cast<std::size_t>(value.size())};
+    };
+    return sort_order_ == Qt::AscendingOrder ? bytes(a) < bytes(b) : bytes(b) < bytes(a);
+}
+
+auto Accounts_Table_Model::sorted_ids(QVector<int> positions) const -> QVector<core::Account_Id>
+{
+    if (static_cast<Field>(sort_column_) != Field::Password) {
+        std::stable_sort(positions.begin(), positions.end(), [this](int a, int b) { return sorts_before(a, b); });
+    }
+
+    const auto &accounts = store_->accounts();
+    QVector<core::Account_Id> ids;
+    ids.reserve(positions.size());
+    for (const auto position : positions) ids.append(accounts.id(position));
+    return ids;
+}
+
+} // namespace ui
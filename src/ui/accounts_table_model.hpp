@@ -0,0 +1,112 @@
+// =================================================================================
+// ui/accounts_table_model.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/account.hpp"
+#include "core/account_store.hpp"
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace ui {
+
+/// @class Accounts_Table_Model
+/// @brief A table model that reads the note, username and password columns straight out of the account store.
+///
+/// Nothing is copied per account: data() decodes a field only when a view asks for
+/// it, which is just for the rows on screen. Unsorted and unfiltered, row N is
+/// position N in the store and the model holds no per-row state. Only a sort or a
+/// search keeps a list of account IDs, plus a hash from each ID back to its row.
+///
+/// The model follows the store's change signals with targeted row inserts, removals
+/// and data changes, so selection and scroll position survive edits. Edited accounts
+/// keep their row even if they no longer match the sort or search until the next
+/// sort or query.
+///
+/// Passwords are masked for display; the edit role returns the real one.
+class Accounts_Table_Model final : public QAbstractTableModel {
+    Q_OBJECT
+
+  public:
+    /// @brief The columns in display order; they match core::Account_Columns::Field.
+    enum Column { Note, Username, Password, Column_Count };
+
+    /// @brief Constructs the model over a store, showing every account in store order.
+    explicit Accounts_Table_Model(core::Account_Store *store, QObject *parent = nullptr);
+
+    auto rowCount(const QModelIndex &parent = {}) const -> int override;
+    auto columnCount(const QModelIndex &parent = {}) const -> int override;
+    auto data(const QModelIndex &index, int role = Qt::DisplayRole) const -> QVariant override;
+    auto headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const -> QVariant override;
+    auto flags(const QModelIndex &index) const -> Qt::ItemFlags override;
+
+    /// @brief Writes an edited field back to the store.
+    auto setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) -> bool override;
+
+    /// @brief Orders the rows by a column; a negative column restores store order.
+    auto sort(int column, Qt::SortOrder order = Qt::AscendingOrder) -> void override;
+
+    /// @brief Shows only the accounts matching a search query, best match first; an empty query shows all.
+    auto set_query(const QString &query) -> void;
+
+    /// @brief Returns the ID of the account shown in a row, or 0 if the row is out of range.
+    auto id_at(int row) const -> core::Account_Id;
+
+    /// @brief Returns the row showing an account, or -1 if it is not shown.
+    auto row_of(core::Account_Id id) const -> int;
+
+  signals:
+    /// @brief Emitted when an edit could not be applied to the store; the old value is kept.
+    auto update_failed() -> void;
+
+  private:
+    /// @brief Adds rows for the accounts appended to the store at the positions first to last.
+    auto on_accounts_inserted(int first, int last) -> void;
+
+    /// @brief Drops the rows of the accounts removed from the store.
+    auto on_accounts_removed(int first, int last, const QVector<core::Account_Id> &ids) -> void;
+
+    /// @brief Repaints the rows of the accounts replaced in the store.
+    auto on_accounts_changed(int first, int last, const QVector<core::Account_Id> &ids) -> void;
+
+    /// @brief Points row_by_id_ at the rows from a given one to the end, after rows_ moved.
+    auto renumber_rows(int from) -> void;
+
+    /// @brief Rebuilds rows_ from the query and sort state without notifying views.
+    auto rebuild_rows() -> void;
+
+    /// @brief Resets the model to the current query and sort state.
+    auto reload() -> void;
+
+    /// @brief Returns true if the account at one store position sorts before the one at another.
+    auto sorts_before(int a, int b) const -> bool;
+
+    /// @brief Returns the IDs of the given store positions ordered by the sort column.
+    auto sorted_ids(QVector<int> positions) const -> QVector<core::Account_Id>;
+
+  private:
+    core::Account_Store *store_;
+
+    /// @brief The ID shown in each row; unused while rows follow the store order.
+    QVector<core::Account_Id> rows_;
+
+    /// @brief The row of every ID in rows_, so updates find their row without a scan.
+    QHash<core::Account_Id, int> row_by_id_;
+
+    /// @brief True while row N is store position N, so rows_ is left empty.
+    bool follows_store_ = true;
+
+    /// @brief The number of rows while they follow the store. The store announces changes
+    /// after making them, so its own size is already ahead while rows are inserted or removed.
+    int store_rows_ = 0;
+
+    QString query_;
+    int sort_column_ = -1;
+    Qt::SortOrder sort_order_ = Qt::AscendingOrder;
+};
+
+} // namespace ui
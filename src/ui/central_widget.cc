@@ -6,10 +6,11 @@
 
 namespace ui {
 
-Central_Widget::Central_Widget(core::Theme_Config *theme_config, QWidget *parent)
+Central_Widget::Central_Widget(core::Theme_Service *theme_service, QWidget *parent)
     : QWidget(parent)
-    , theme_config_{theme_config}
+    , theme_service_{theme_service}
 {
+    QWidget::connect(theme_service_, &core::Theme_Service::theme_changed, this, [this] { update(); });
 }
 
 auto Central_Widget::paintEvent(QPaintEvent *event) -> void
@@ -26,7 +27,7 @@ auto Central_Widget::paintEvent(QPaintEvent *event) -> void
     auto pen = QPen{QColor{"#616161"}, 1};
     painter.setPen(pen);
 
-    auto brush = QBrush{theme_config_->load().background_dark};
+    auto brush = QBrush{theme_service_->theme().background_dark};
     painter.setBrush(brush);
 
     painter.drawPath(path);
@@ -8,7 +8,7 @@
 #include <QPainterPath>
 #include <QWidget>
 
-#include "core/theme.hpp"
+#include "core/theme_service.hpp"
 
 namespace ui {
 
@@ -20,9 +20,9 @@ namespace ui {
 class Central_Widget : public QWidget {
   public:
     /// @brief Constructs the central widget.
-    /// @param theme_config A pointer to the application's theme configuration for styling.
+    /// @param theme_service The application's theme service; the widget repaints when the theme changes.
     /// @param parent The parent widget.
-    explicit Central_Widget(core::Theme_Config *theme_config, QWidget *parent = nullptr);
+    explicit Central_Widget(core::Theme_Service *theme_service, QWidget *parent = nullptr);
 
   protected:
     /// @brief Handles the paint event to draw the custom background.
@@ -30,8 +30,8 @@ class Central_Widget : public QWidget {
     auto paintEvent(QPaintEvent *event) -> void override;
 
   private:
-    /// @brief A pointer to the theme configuration used for styling the widget.
-    core::Theme_Config *theme_config_;
+    /// @brief The theme service used for styling the widget; read from memory on every paint.
+    core::Theme_Service *theme_service_;
 };
 
 } // namespace ui
@@ -4,35 +4,29 @@
 
 #include "ui/control_bar.hpp"
 
-#include <QCoreApplication>
+#include "core/asset_pack.hpp"
+#include "ui/icon_atlas.hpp"
+#include "ui/thumbnail_cache.hpp"
+
 #include <QHBoxLayout>
 
+#include <QEvent>
 #include <QIcon>
-#include <QPainter>
+#include <QMetaObject>
 #include <QPixmap>
-#include <QSvgRenderer>
 #include <QWidget>
 
-namespace ui {
-
-// TODO move this out of here or something, could be useful in other places
-auto create_colorized_pixmap(const QString &path, const QColor &color, const QSize &size) -> QPixmap
-{
-    auto renderer = QSvgRenderer{path};
-    if (!renderer.isValid()) return QPixmap{};
-
-    auto pixmap = QPixmap{size};
-    pixmap.fill(Qt::transparent);
+#include <initializer_list>
+#include <string_view>
 
-    auto painter = QPainter{&pixmap};
-    renderer.render(&painter);
+namespace ui {
 
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(pixmap.rect(), color);
-    painter.end();
+/// @brief The logical size the control icons are drawn at.
+static constexpr auto CONTROL_ICON_SIZE = QSize{20, 20};
 
-    return pixmap;
-}
+static constexpr std::string_view LOGIN_ICON = "icons/log-in.svg";
+static constexpr std::string_view ADD_ACCOUNT_ICON = "icons/add-file.svg";
+static constexpr std::string_view REMOVE_ACCOUNT_ICON = "icons/erase.svg";
 
 Control_Bar::Control_Bar(QWidget *parent)
     : QWidget{parent}
@@ -48,34 +42,48 @@ Control_Bar::Control_Bar(QWidget *parent)
     add_account_button_->setObjectName("add_account_button");
     remove_account_button_->setObjectName("remove_account_button");
 
-    const QString icons_path = QCoreApplication::applicationDirPath() + "/icons";
-
-    auto create_control_icon = [&](const char *path) -> QIcon {
-        auto icon = QIcon{};
+    load_control_icons();
+    setup_ui();
+}
 
-        constexpr auto icon_size = QSize{36, 36};
-        const QColor icon_color = palette().color(QPalette::ButtonText);
-        const QColor disabled_color = palette().color(QPalette::Disabled, QPalette::ButtonText);
+Control_Bar::~Control_Bar()
+{
+    icon_pool_.waitForDone();
+}
 
-        const QPixmap normal = create_colorized_pixmap(icons_path + path, icon_color, icon_size);
-        const QPixmap disabled = create_colorized_pixmap(icons_path + path, disabled_color, icon_size);
+auto Control_Bar::load_control_icons() -> void
+{
+    const auto device_pixel_ratio = devicePixelRatioF();
+
+    // only the first rasterization of each mask runs off the UI thread; coloring them is cheap
+    icon_pool_.start([this, device_pixel_ratio] {
+        for (const auto name : {LOGIN_ICON, ADD_ACCOUNT_ICON, REMOVE_ACCOUNT_ICON}) {
+            Icon_Atlas::instance().mask(name, CONTROL_ICON_SIZE, device_pixel_ratio);
+        }
+        QMetaObject::invokeMethod(this, &Control_Bar::recolor_control_icons, Qt::QueuedConnection);
+    });
+}
 
-        icon.addPixmap(normal, QIcon::Normal);
-        icon.addPixmap(disabled, QIcon::Disabled);
+auto Control_Bar::recolor_control_icons() -> void
+{
+    const QColor icon_color = palette().color(QPalette::ButtonText);
+    const QColor disabled_color = palette().color(QPalette::Disabled, QPalette::ButtonText);
 
-        return icon;
+    const auto set_icon = [&](QPushButton *button, std::string_view name) {
+        const auto icon = Icon_Atlas::instance().icon(name, CONTROL_ICON_SIZE, devicePixelRatioF(), icon_color, disabled_color);
+        if (!icon.isNull()) button->setIcon(icon);
     };
 
-    const QIcon login_icon = create_control_icon("/log-in.svg");
-    login_button_->setIcon(login_icon);
-
-    const QIcon add_account_icon = create_control_icon("/add-file.svg");
-    add_account_button_->setIcon(add_account_icon);
-
-    const QIcon remove_account_icon = create_control_icon("/erase.svg");
-    remove_account_button_->setIcon(remove_account_icon);
+    set_icon(login_button_, LOGIN_ICON);
+    set_icon(add_account_button_, ADD_ACCOUNT_ICON);
+    set_icon(remove_account_button_, REMOVE_ACCOUNT_ICON);
+}
 
-    setup_ui();
+auto Control_Bar::changeEvent(QEvent *event) -> void
+{
+    // theme changes arrive as a new palette or style sheet; the masks stay cached so this only re-tints
+    if (event->type() == QEvent::PaletteChange || event->type() == QEvent::StyleChange) recolor_control_icons();
+    QWidget::changeEvent(event);
 }
 
 auto Control_Bar::set_controls_enabled(bool enabled) -> void
@@ -84,10 +92,11 @@ auto Control_Bar::set_controls_enabled(bool enabled) -> void
     remove_account_button_->setEnabled(enabled);
 }
 
-auto Control_Bar::update_game_context(riot::Game game, const QString &icon_path) -> void
+auto Control_Bar::update_game_context(riot::Game game, const QString &icon_name) -> void
 {
-    const auto game_icon = QIcon{icon_path};
-    game_icon_label_->setPixmap(game_icon.pixmap(QSize{32, 32}));
+    const auto icon_asset = core::Asset_Pack::application().find(icon_name.toStdString());
+    const auto game_icon = load_thumbnail(icon_asset, QSize{32, 32}, devicePixelRatioF());
+    game_icon_label_->setPixmap(QPixmap::fromImage(game_icon));
     game_icon_label_->show();
 
     login_button_->show();
@@ -101,16 +110,15 @@ auto Control_Bar::setup_ui() -> void
     layout->setContentsMargins(10, 0, 15, 0);
     layout->setSpacing(10);
 
-    constexpr auto icon_size = QSize{20, 20};
     constexpr auto button_size = QSize{40, 30};
 
-    login_button_->setIconSize(icon_size);
+    login_button_->setIconSize(CONTROL_ICON_SIZE);
     login_button_->setFixedSize(button_size);
 
-    add_account_button_->setIconSize(icon_size);
+    add_account_button_->setIconSize(CONTROL_ICON_SIZE);
     add_account_button_->setFixedSize(button_size);
 
-    remove_account_button_->setIconSize(icon_size);
+    remove_account_button_->setIconSize(CONTROL_ICON_SIZE);
     remove_account_button_->setFixedSize(button_size);
 
     layout->addWidget(login_button_);
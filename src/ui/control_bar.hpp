@@ -7,6 +7,7 @@
 #include "riot/client.hpp"
 #include <QLabel>
 #include <QPushButton>
+#include <QThreadPool>
 #include <QWidget>
 
 namespace ui {
@@ -23,7 +24,9 @@ class Control_Bar final : public QWidget {
     /// @brief Constructs the control bar.
     /// @param parent The parent widget.
     explicit Control_Bar(QWidget *parent = nullptr);
-    ~Control_Bar() override = default;
+
+    /// @brief Waits for the icon rasterization, which reports back to the bar.
+    ~Control_Bar() override;
 
     /// @brief Enables or disables controls based on account selection.
     /// @param enabled True to enable controls, false to disable.
@@ -31,8 +34,8 @@ class Control_Bar final : public QWidget {
 
     /// @brief Updates the bar's UI to reflect the current game context.
     /// @param game The currently selected game.
-    /// @param icon_path The file path to the icon for the specified game.
-    auto update_game_context(riot::Game game, const QString &icon_path) -> void;
+    /// @param icon_name The asset name of the icon for the specified game, e.g. "icons/league-icon.png".
+    auto update_game_context(riot::Game game, const QString &icon_name) -> void;
 
   signals:
     /// @brief Emitted when the user clicks the login button.
@@ -44,10 +47,20 @@ class Control_Bar final : public QWidget {
     /// @brief Emitted when the user clicks the remove account button.
     auto remove_account_clicked() -> void;
 
+  protected:
+    /// @brief Recolors the icons when the palette or style sheet changes.
+    auto changeEvent(QEvent *event) -> void override;
+
   private:
     /// @brief Sets up the widgets, layout, and connections for the bar.
     auto setup_ui() -> void;
 
+    /// @brief Rasterizes the button icon masks into the icon atlas on the thread pool, then colors them.
+    auto load_control_icons() -> void;
+
+    /// @brief Tints the cached icon masks with the current palette and sets them on the buttons.
+    auto recolor_control_icons() -> void;
+
   private:
     /// @brief Displays a small icon of the icon of the currently selected game.
     QLabel *game_icon_label_;
@@ -55,6 +68,9 @@ class Control_Bar final : public QWidget {
     QPushButton *login_button_;
     QPushButton *add_account_button_;
     QPushButton *remove_account_button_;
+
+    /// @brief Rasterizes the icon masks off the UI thread; drained before the bar is destroyed.
+    QThreadPool icon_pool_;
 };
 
 } // namespace ui
@@ -0,0 +1,175 @@
+// =================================================================================
+// ui/icon_atlas.cc
+// =================================================================================
+
+#include "ui/icon_atlas.hpp"
+
+#include "core/asset_pack.hpp"
+
+#include <QMutexLocker>
+#include <QPainter>
+#include <QPixmap>
+#include <QSvgRenderer>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define ICON_ATLAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define ICON_ATLAS_SSE2 0
+#endif
+
+namespace ui {
+
+namespace {
+
+/// @brief Scales a premultiplied channel by a coverage value, rounding like qt_div_255.
+auto scale_by(std::uint32_t channel, std::uint32_t alpha) -> std::uint32_t
+{
+    const auto t = channel * alpha + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+auto tint_row_scalar(const uchar *mask, std::uint32_t *out, int count, QRgb color) -> void
+{
+    for (int i = 0; i < count; ++i) {
+        const auto a = static_cast<std::uint32_t>(mask[i]);
+        out[i] = scale_by(static_cast<std::uint32_t>(qAlpha(color)), a) << 24 | scale_by(static_cast<std::uint32_t>(qRed(color)), a) << 16
+                 | scale_by(static_cast<std::uint32_t>(qGreen(color)), a) << 8 | scale_by(static_cast<std::uint32_t>(qBlue(color)), a);
+    }
+}
+
+#if ICON_ATLAS_SSE2
+
+/// @brief Tints four pixels per step; SSE2 is part of every x64 CPU so there is no dispatch.
+auto tint_row_sse2(const uchar *mask, std::uint32_t *out, int count, QRgb color) -> void
+{
+    // the pixels are stored as B, G, R, A bytes, so the color is spread in that order
+    const auto b = static_cast<short>(qBlue(color));
+    const auto g = static_cast<short>(qGreen(color));
+    const auto r = static_cast<short>(qRed(color));
+    const auto a = static_cast<short>(qAlpha(color));
+    const auto color16 = _mm_setr_epi16(b, g, r, a, b, g, r, a);
+    const auto zero = _mm_setzero_si128();
+    const auto half = _mm_set1_epi16(128);
+
+    const auto scale = [&](__m128i alpha16) {
+        const auto t = _mm_add_epi16(_mm_mullo_epi16(alpha16, color16), half);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    };
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        std::uint32_t alphas;
+        std::memcpy(&alphas, mask + i, sizeof(alphas));
+
+        // a0 a0 a1 a1 a2 a2 a3 a3, then each alpha repeated for the four channels of its pixel
+        auto alpha16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(alphas)), zero);
+        alpha16 = _mm_unpacklo_epi16(alpha16, alpha16);
+        const auto low = scale(_mm_unpacklo_epi32(alpha16, alpha16));
+        const auto high = scale(_mm_unpackhi_epi32(alpha16, alpha16));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(low, high));
+    }
+
+    tint_row_scalar(mask + i, out + i, count - i, color);
+}
+
+#endif
+
+auto tint_row(const uchar *mask, std::uint32_t *out, int count, QRgb color) -> void
+{
+#if ICON_ATLAS_SSE2
+    tint_row_sse2(mask, out, count, color);
+#else
+    tint_row_scalar(mask, out, count, color);
+#endif
+}
+
+auto rasterize_mask(const QByteArray &svg, const QSize &size, qreal device_pixel_ratio) -> QImage
+{
+    auto renderer = QSvgRenderer{svg};
+    if (!renderer.isValid()) return QImage{};
+
+    auto image = QImage{size * device_pixel_ratio, QImage::Format_ARGB32_Premultiplied};
+    image.fill(Qt::transparent);
+
+    auto painter = QPainter{&image};
+    renderer.render(&painter);
+    painter.end();
+
+    auto mask = image.convertToFormat(QImage::Format_Alpha8);
+    mask.setDevicePixelRatio(device_pixel_ratio);
+    return mask;
+}
+
+} // namespace
+
+auto Icon_Atlas::instance() -> Icon_Atlas &
+{
+    static auto atlas = Icon_Atlas{};
+    return atlas;
+}
+
+auto Icon_Atlas::mask(std::string_view name, const QSize &size, qreal device_pixel_ratio) -> QImage
+{
+    const auto key = key_for(name, size, device_pixel_ratio);
+    {
+        const auto lock = QMutexLocker{&mutex_};
+        if (const auto it = masks_.constFind(key); it != masks_.cend()) return *it;
+    }
+
+    // rasterize without the lock; two threads racing on one icon just render it twice
+    auto mask = rasterize_mask(core::Asset_Pack::application().find(name).data, size, device_pixel_ratio);
+    if (mask.isNull()) return mask;
+
+    const auto lock = QMutexLocker{&mutex_};
+    return *masks_.insert(key, std::move(mask));
+}
+
+auto Icon_Atlas::cached_mask(std::string_view name, const QSize &size, qreal device_pixel_ratio) const -> QImage
+{
+    const auto lock = QMutexLocker{&mutex_};
+    return masks_.value(key_for(name, size, device_pixel_ratio));
+}
+
+auto Icon_Atlas::icon(std::string_view name, const QSize &size, qreal device_pixel_ratio, const QColor &normal,
+                      const QColor &disabled) const -> QIcon
+{
+    const auto mask = cached_mask(name, size, device_pixel_ratio);
+    if (mask.isNull()) return QIcon{};
+
+    auto icon = QIcon{};
+    icon.addPixmap(QPixmap::fromImage(tint_mask(mask, normal)), QIcon::Normal);
+    icon.addPixmap(QPixmap::fromImage(tint_mask(mask, disabled)), QIcon::Disabled);
+    return icon;
+}
+
+auto Icon_Atlas::key_for(std::string_view name, const QSize &size, qreal device_pixel_ratio) -> QString
+{
+    return QString{"%1@%2x%3@%4"}
+        .arg(QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size())))
+        .arg(size.width())
+        .arg(size.height())
+        .arg(qRound(device_pixel_ratio * 100));
+}
+
+auto tint_mask(const QImage &mask, const QColor &color) -> QImage
+{
+    if (mask.isNull() || mask.format() != QImage::Format_Alpha8) return QImage{};
+
+    auto image = QImage{mask.size(), QImage::Format_ARGB32_Premultiplied};
+    image.setDevicePixelRatio(mask.devicePixelRatio());
+
+    const auto premultiplied = qPremultiply(color.rgba());
+    for (int y = 0; y < mask.height(); ++y) {
+        tint_row(mask.constScanLine(y), reinterpret_cast<std::uint32_t *>(image.scanLine(y)), mask.width(), premultiplied);
+    }
+
+    return image;
+}
+
+} // namespace ui
@@ -0,0 +1,57 @@
+// =================================================================================
+// ui/icon_atlas.hpp
+// =================================================================================
+
+#pragma once
+
+#include <QColor>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+#include <string_view>
+
+namespace ui {
+
+/// @class Icon_Atlas
+/// @brief A process-wide cache of SVG icons rasterized once into alpha masks.
+///
+/// Each icon is rendered once per size and device pixel ratio and only its coverage is
+/// kept. Any color is then a single pass over the mask, so recoloring the icons after a
+/// theme change never touches the SVG renderer again.
+///
+/// @note Masks may be rasterized and tinted from any thread.
+class Icon_Atlas final {
+  public:
+    /// @brief Returns the atlas shared by every widget.
+    static auto instance() -> Icon_Atlas &;
+
+    /// @brief Returns the mask of an SVG asset at a logical size, rasterizing it on first use.
+    /// @param name The asset name of the SVG, e.g. "icons/log-in.svg".
+    auto mask(std::string_view name, const QSize &size, qreal device_pixel_ratio) -> QImage;
+
+    /// @brief Returns the mask if it was rasterized already, otherwise a null image.
+    auto cached_mask(std::string_view name, const QSize &size, qreal device_pixel_ratio) const -> QImage;
+
+    /// @brief Builds an icon from a cached mask with a color for the normal and disabled modes.
+    /// @return A null icon if the mask has not been rasterized yet.
+    auto icon(std::string_view name, const QSize &size, qreal device_pixel_ratio, const QColor &normal, const QColor &disabled) const
+        -> QIcon;
+
+  private:
+    Icon_Atlas() = default;
+
+    static auto key_for(std::string_view name, const QSize &size, qreal device_pixel_ratio) -> QString;
+
+  private:
+    mutable QMutex mutex_;
+    QHash<QString, QImage> masks_;
+};
+
+/// @brief Fills a color in under an Alpha8 mask, giving a premultiplied ARGB32 image with the mask's device pixel ratio.
+auto tint_mask(const QImage &mask, const QColor &color) -> QImage;
+
+} // namespace ui
@@ -0,0 +1,52 @@
+// =================================================================================
+// ui/mip_pyramid.cc
+// =================================================================================
+
+#include "ui/mip_pyramid.hpp"
+
+#include <iterator>
+
+namespace ui {
+
+Mip_Pyramid::Mip_Pyramid(const QImage &source)
+{
+    if (source.isNull()) return;
+
+    levels_.append(source);
+    while (levels_.last().width() / 2 >= MIN_LEVEL_SIZE && levels_.last().height() / 2 >= MIN_LEVEL_SIZE) {
+        const auto &previous = levels_.last();
+        levels_.append(previous.scaled(previous.width() / 2, previous.height() / 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+}
+
+auto Mip_Pyramid::is_null() const -> bool
+{
+    return levels_.isEmpty();
+}
+
+auto Mip_Pyramid::size() const -> QSize
+{
+    return is_null() ? QSize{} : levels_.first().size();
+}
+
+auto Mip_Pyramid::level_for(const QSize &target) const -> const QImage &
+{
+    // levels shrink monotonically, so the last one that still covers the target is the best source
+    auto level = levels_.cbegin();
+    for (auto next = std::next(level); next != levels_.cend(); ++next) {
+        if (next->width() < target.width() || next->height() < target.height()) break;
+        level = next;
+    }
+    return *level;
+}
+
+auto Mip_Pyramid::scaled(const QSize &target, Qt::TransformationMode mode) const -> QPixmap
+{
+    if (is_null() || target.isEmpty()) return {};
+
+    // fit against the full-size level so every level yields the same pixel size
+    const auto fitted = size().scaled(target, Qt::KeepAspectRatio);
+    return QPixmap::fromImage(level_for(fitted).scaled(fitted, Qt::IgnoreAspectRatio, mode));
+}
+
+} // namespace ui
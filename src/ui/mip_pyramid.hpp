@@ -0,0 +1,50 @@
+// =================================================================================
+// ui/mip_pyramid.hpp
+// =================================================================================
+
+#pragma once
+
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+#include <QVector>
+
+namespace ui {
+
+/// @class Mip_Pyramid
+/// @brief An image stored at its full size and at successively halved sizes.
+///
+/// Scaling to a display size starts from the smallest level that is still at least
+/// as large as the target, so a resize resamples a few hundred pixels per side
+/// instead of the full source. Building the levels only uses QImage, so it may run
+/// on any thread.
+class Mip_Pyramid final {
+  public:
+    /// @brief Constructs an empty pyramid.
+    Mip_Pyramid() = default;
+
+    /// @brief Builds every level down to MIN_LEVEL_SIZE from a source image.
+    explicit Mip_Pyramid(const QImage &source);
+
+    /// @brief Returns whether the pyramid has no image.
+    auto is_null() const -> bool;
+
+    /// @brief Returns the size of the full-resolution level.
+    auto size() const -> QSize;
+
+    /// @brief Returns the smallest level that covers the target size.
+    auto level_for(const QSize &target) const -> const QImage &;
+
+    /// @brief Scales the image to fit inside the target size, keeping its aspect ratio.
+    auto scaled(const QSize &target, Qt::TransformationMode mode) const -> QPixmap;
+
+  private:
+    /// @brief Levels are not halved below this size on either side.
+    static constexpr int MIN_LEVEL_SIZE = 64;
+
+  private:
+    /// @brief The levels from the full size down; each is half the size of the previous one.
+    QVector<QImage> levels_;
+};
+
+} // namespace ui
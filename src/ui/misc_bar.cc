@@ -34,6 +34,25 @@ auto Misc_Bar::setup_ui() -> void
     action_customize_theme->setIcon(QIcon::fromTheme("weather-clear"));
     connect(action_customize_theme, &QAction::triggered, this, &Misc_Bar::customize_theme_requested);
 
+    auto *action_native_theme = options_menu_->addAction("native theme");
+    action_native_theme->setCheckable(true);
+    connect(action_native_theme, &QAction::toggled, this, &Misc_Bar::native_theme_toggled);
+
+    auto *action_system_window_drag = options_menu_->addAction("system window drag");
+    action_system_window_drag->setCheckable(true);
+    action_system_window_drag->setChecked(true);
+    connect(action_system_window_drag, &QAction::toggled, this, &Misc_Bar::system_window_drag_toggled);
+
+    options_menu_->addSeparator();
+
+    auto *action_import_accounts = options_menu_->addAction("import accounts");
+    action_import_accounts->setIcon(QIcon::fromTheme("document-import"));
+    connect(action_import_accounts, &QAction::triggered, this, &Misc_Bar::import_accounts_requested);
+
+    auto *action_export_accounts = options_menu_->addAction("export accounts");
+    action_export_accounts->setIcon(QIcon::fromTheme("document-export"));
+    connect(action_export_accounts, &QAction::triggered, this, &Misc_Bar::export_accounts_requested);
+
     options_menu_->addSeparator();
 
     auto *action_check_for_updates = options_menu_->addAction("check for updates");
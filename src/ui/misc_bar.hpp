@@ -15,7 +15,7 @@ namespace ui {
 /// @brief A vertical side bar containing a menu for miscellaneous actions.
 ///
 /// This widget provides access to application-wide functionalities like theme
-/// customization, update checks, and opening the configuration directory.
+/// customization, update checks, account import and export, and opening the configuration directory.
 class Misc_Bar final : public QWidget {
     Q_OBJECT
 
@@ -29,12 +29,26 @@ class Misc_Bar final : public QWidget {
     /// @brief Emitted when the user requests to customize the theme.
     auto customize_theme_requested() -> void;
 
+    /// @brief Emitted when the user switches between stylesheet and native theming.
+    /// @param native True to theme through the native style and palette.
+    auto native_theme_toggled(bool native) -> void;
+
+    /// @brief Emitted when the user switches between system-driven and hand-rolled window dragging.
+    /// @param enabled True to let the windowing system move and resize the window.
+    auto system_window_drag_toggled(bool enabled) -> void;
+
     /// @brief Emitted when the user requests to check for application updates.
     auto check_for_updates_requested() -> void;
 
     /// @brief Emitted when the user requests to open the config directory.
     auto open_config_directory_requested() -> void;
 
+    /// @brief Emitted when the user requests to import accounts from a file.
+    auto import_accounts_requested() -> void;
+
+    /// @brief Emitted when the user requests to export all accounts to a file.
+    auto export_accounts_requested() -> void;
+
   private:
     /// @brief Sets up the widgets, layout, and connections for the bar.
     auto setup_ui() -> void;
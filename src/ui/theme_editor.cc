@@ -3,6 +3,7 @@
 // =================================================================================
 
 #include "theme_editor.hpp"
+#include "core/stylesheet_template.hpp"
 #include "core/theme.hpp"
 
 #include <QGroupBox>
@@ -12,6 +13,9 @@
 
 namespace ui {
 
+/// @brief How long window previews are held back while a color is being dragged.
+static constexpr int WINDOW_PREVIEW_DELAY_MS = 50;
+
 Theme_Editor::Theme_Editor(core::Theme &theme, QWidget *parent)
     : QDialog{parent}
     , current_theme_{theme}
@@ -54,6 +58,10 @@ Theme_Editor::Theme_Editor(core::Theme &theme, QWidget *parent)
     preview_disabled_button_ = new QPushButton{"Disabled Button"};
     preview_disabled_button_->setEnabled(false);
     preview_disabled_label_ = new QLabel{"Disabled Text"};
+    preview_in_window_check_ = new QCheckBox{"Preview in window"};
+    window_preview_timer_ = new QTimer{this};
+    window_preview_timer_->setSingleShot(true);
+    window_preview_timer_->setInterval(WINDOW_PREVIEW_DELAY_MS);
 
     preview_layout->addWidget(preview_label_);
     preview_layout->addWidget(preview_line_edit_);
@@ -69,6 +77,7 @@ Theme_Editor::Theme_Editor(core::Theme &theme, QWidget *parent)
     auto *button_layout = new QHBoxLayout{};
     auto *save_button = new QPushButton{"Save"};
     auto *cancel_button = new QPushButton{"Cancel"};
+    button_layout->addWidget(preview_in_window_check_);
     button_layout->addStretch();
     button_layout->addWidget(save_button);
     button_layout->addWidget(cancel_button);
@@ -79,8 +88,74 @@ Theme_Editor::Theme_Editor(core::Theme &theme, QWidget *parent)
 
     connect(save_button, &QPushButton::clicked, this, &Theme_Editor::on_save_button_clicked);
     connect(cancel_button, &QPushButton::clicked, this, &Theme_Editor::on_cancel_button_clicked);
-
-    update_previews();
+    connect(window_preview_timer_, &QTimer::timeout, this, [this] {
+        if (preview_in_window_check_->isChecked()) emit preview_requested(current_theme_);
+    });
+    connect(preview_in_window_check_, &QCheckBox::toggled, this, [this](bool checked) {
+        if (checked) {
+            emit preview_requested(current_theme_);
+        } else {
+            window_preview_timer_->stop();
+            emit preview_reverted();
+        }
+    });
+
+    static const auto group_template = core::Stylesheet_Template{
+        "QGroupBox#preview_group {"
+        "    background-color: ${background_dark};"
+        "    border: 1px solid ${border};"
+        "    margin-top: 4px;"
+        "}"
+        "QGroupBox#preview_group::title {"
+        "    color: ${text_primary};"
+        "    subcontrol-origin: margin;"
+        "    subcontrol-position: top center;"
+        "    padding: 0 5px;"
+        "}"};
+    static const auto label_template = core::Stylesheet_Template{"color: ${text_primary}; background-color: transparent; border: none;"};
+    static const auto line_edit_template =
+        core::Stylesheet_Template{"background-color: ${background_light}; color: ${text_primary}; border: 1px solid ${border};"};
+    static const auto table_template = core::Stylesheet_Template{
+        "QTableWidget {"
+        "    background-color: ${background_light};"
+        "    color: ${text_primary};"
+        "    border: 1px solid ${border};"
+        "}"
+        "QTableWidget::item {"
+        "    color: ${text_primary};"
+        "}"
+        "QHeaderView::section {"
+        "    background-color: ${background_light};"
+        "    color: ${text_primary};"
+        "    border: 1px solid ${border};"
+        "}"};
+    static const auto button_template = core::Stylesheet_Template{
+        "QPushButton {"
+        "    background-color: ${button_primary};"
+        "    color: ${text_primary};"
+        "    border: 1px solid ${border};"
+        "}"
+        "QPushButton:hover {"
+        "    background-color: ${button_hover};"
+        "}"};
+    static const auto disabled_button_template = core::Stylesheet_Template{
+        "QPushButton {"
+        "    border: 1px solid ${border};"
+        "}"
+        "QPushButton:disabled {"
+        "    background-color: ${button_disabled};"
+        "    color: ${text_disabled};"
+        "}"};
+    static const auto disabled_label_template =
+        core::Stylesheet_Template{"color: ${text_disabled}; background-color: transparent; border: none;"};
+
+    bind_preview(preview_group_, group_template);
+    bind_preview(preview_label_, label_template);
+    bind_preview(preview_line_edit_, line_edit_template);
+    bind_preview(preview_table_, table_template);
+    bind_preview(preview_button_, button_template);
+    bind_preview(preview_disabled_button_, disabled_button_template);
+    bind_preview(preview_disabled_label_, disabled_label_template);
 }
 
 auto Theme_Editor::create_color_picker(const QString &label, QColor &color_ref) -> void
@@ -90,6 +165,7 @@ auto Theme_Editor::create_color_picker(const QString &label, QColor &color_ref)
 
     form_layout_->addRow(label, button);
     color_map_[button] = &color_ref;
+    update_swatch(button, color_ref);
 
     connect(button, &QPushButton::clicked, this, &Theme_Editor::on_color_button_clicked);
 }
@@ -99,70 +175,62 @@ auto Theme_Editor::on_color_button_clicked() -> void
     auto *button = qobject_cast<QPushButton *>(sender());
     if (!button || !color_map_.contains(button)) return;
 
-    QColor &current_color = *color_map_[button];
-    const QColor new_color = QColorDialog::getColor(current_color, this, "Select Color");
-
-    if (new_color.isValid()) {
-        current_color = new_color;
-        update_previews();
+    if (!color_dialog_) {
+        color_dialog_ = new QColorDialog{this};
+        color_dialog_->setWindowTitle("Select Color");
+        connect(color_dialog_, &QColorDialog::currentColorChanged, this, &Theme_Editor::on_current_color_changed);
+        connect(color_dialog_, &QDialog::rejected, this, &Theme_Editor::on_color_dialog_rejected);
     }
+
+    // detach first so seeding the dialog does not write into the previous field
+    editing_color_ = nullptr;
+    color_dialog_->setCurrentColor(*color_map_[button]);
+
+    editing_color_ = color_map_[button];
+    original_color_ = *editing_color_;
+
+    color_dialog_->show();
+    color_dialog_->raise();
+    color_dialog_->activateWindow();
+}
+
+auto Theme_Editor::on_current_color_changed(const QColor &color) -> void
+{
+    if (!editing_color_ || !color.isValid() || color == *editing_color_) return;
+
+    *editing_color_ = color;
+    update_field(editing_color_);
+
+    if (preview_in_window_check_->isChecked()) window_preview_timer_->start();
 }
 
-auto Theme_Editor::update_previews() -> void
+auto Theme_Editor::on_color_dialog_rejected() -> void
+{
+    if (!editing_color_) return;
+
+    on_current_color_changed(original_color_);
+    editing_color_ = nullptr;
+}
+
+auto Theme_Editor::bind_preview(QWidget *widget, const core::Stylesheet_Template &stylesheet) -> void
+{
+    widget->setStyleSheet(stylesheet.render(current_theme_));
+
+    for (const auto field : stylesheet.fields()) bindings_[&(current_theme_.*field)].append({widget, &stylesheet});
+}
+
+auto Theme_Editor::update_field(const QColor *color) -> void
 {
     for (auto it = color_map_.begin(); it != color_map_.end(); ++it) {
-        it.key()->setStyleSheet(QString{"background-color: %1;"}.arg(it.value()->name()));
+        if (it.value() == color) update_swatch(it.key(), *color);
     }
 
-    const auto preview_stylesheet =
-        QString{"QGroupBox#preview_group {"
-                "    background-color: %1;"
-                "    border: 1px solid %2;"
-                "    margin-top: 4px;"
-                "}"
-                "QGroupBox#preview_group::title {"
-                "    color: %3;"
-                "    subcontrol-origin: margin;"
-                "    subcontrol-position: top center;"
-                "    padding: 0 5px;"
-                "}"
-                "QGroupBox#preview_group QLabel {"
-                "    color: %3;"
-                "    background-color: transparent;"
-                "    border: none;"
-                "}"
-                "QGroupBox#preview_group QPushButton {"
-                "    background-color: %4;"
-                "    color: %3;"
-                "    border: 1px solid %2;"
-                "}"
-                "QGroupBox#preview_group QPushButton:hover {"
-                "    background-color: %5;"
-                "}"
-                "QGroupBox#preview_group QPushButton:disabled {"
-                "    background-color: %6;"
-                "    color: %7;"
-                "}"
-                "QGroupBox#preview_group QLineEdit, QGroupBox#preview_group QTableWidget {"
-                "    background-color: %8;"
-                "    color: %3;"
-                "    border: 1px solid %2;"
-                "}"
-                "QGroupBox#preview_group QTableWidget::item {"
-                "    color: %3;"
-                "}"
-                "QGroupBox#preview_group QHeaderView::section {"
-                "    background-color: %8;"
-                "    color: %3;"
-                "    border: 1px solid %2;"
-                "}"}
-            .arg(current_theme_.background_dark.name(), current_theme_.border.name(), current_theme_.text_primary.name(),
-                 current_theme_.button_primary.name(), current_theme_.button_hover.name(), current_theme_.button_disabled.name(),
-                 current_theme_.text_disabled.name(), current_theme_.background_light.name());
-
-    preview_group_->setStyleSheet(preview_stylesheet);
-    preview_disabled_label_->setStyleSheet(
-        QString{"color: %1; background-color: transparent; border: none;"}.arg(current_theme_.text_disabled.name()));
+    for (const auto &binding : bindings_.value(color)) binding.widget->setStyleSheet(binding.stylesheet->render(current_theme_));
+}
+
+auto Theme_Editor::update_swatch(QPushButton *button, const QColor &color) -> void
+{
+    button->setStyleSheet(QString{"background-color: %1;"}.arg(color.name()));
 }
 
 auto Theme_Editor::on_save_button_clicked() -> void
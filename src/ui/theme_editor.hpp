@@ -4,21 +4,30 @@
 
 #pragma once
 
+#include "core/stylesheet_template.hpp"
 #include "core/theme.hpp"
 
+#include <QCheckBox>
 #include <QColorDialog>
 #include <QDialog>
 #include <QFormLayout>
 #include <QGroupBox>
+#include <QHash>
 #include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QTableWidget>
+#include <QTimer>
+#include <QVector>
 
 namespace ui {
 
 /// @class Theme_Editor
 /// @brief A dialog for editing and previewing application themes.
+///
+/// Colors are picked in a non-modal color dialog and previewed while the selection
+/// is being dragged. Every preview widget is bound to the theme fields its stylesheet
+/// uses, so a change only restyles the widgets that show the changed field.
 class Theme_Editor final : public QDialog {
     Q_OBJECT
 
@@ -28,24 +37,50 @@ class Theme_Editor final : public QDialog {
     /// @param parent The parent widget.
     explicit Theme_Editor(core::Theme &theme, QWidget *parent = nullptr);
 
+  signals:
+    /// @brief Emitted while "preview in window" is checked and the theme was edited.
+    auto preview_requested(const core::Theme &theme) -> void;
+
+    /// @brief Emitted when the window should drop the preview and show the saved theme again.
+    auto preview_reverted() -> void;
+
   private slots:
-    /// @brief Opens a color dialog when a color swatch button is clicked.
+    /// @brief Opens the color dialog for the clicked color swatch button.
     auto on_color_button_clicked() -> void;
 
+    /// @brief Applies the color under the color dialog's cursor to the edited field.
+    auto on_current_color_changed(const QColor &color) -> void;
+
+    /// @brief Restores the edited field when the color dialog is cancelled.
+    auto on_color_dialog_rejected() -> void;
+
     /// @brief Accepts the dialog, signaling that changes should be saved.
     auto on_save_button_clicked() -> void;
 
     /// @brief Rejects the dialog, discarding any changes.
     auto on_cancel_button_clicked() -> void;
 
+  private:
+    /// @brief A preview widget and the template its stylesheet is rendered from.
+    struct Preview_Binding {
+        QWidget *widget;
+        const core::Stylesheet_Template *stylesheet;
+    };
+
   private:
     /// @brief Creates a color picker widget and adds it to the form.
     /// @param label The text label for the color picker.
     /// @param color_ref A reference to the QColor object to be modified.
     auto create_color_picker(const QString &label, QColor &color_ref) -> void;
 
-    /// @brief Updates the preview widgets with the current theme colors.
-    auto update_previews() -> void;
+    /// @brief Styles a preview widget and registers it under every theme field its template uses.
+    auto bind_preview(QWidget *widget, const core::Stylesheet_Template &stylesheet) -> void;
+
+    /// @brief Restyles the swatch and the preview widgets bound to one theme field.
+    auto update_field(const QColor *color) -> void;
+
+    /// @brief Sets a swatch button's background to its color.
+    static auto update_swatch(QPushButton *button, const QColor &color) -> void;
 
   private:
     QFormLayout *form_layout_;
@@ -56,6 +91,17 @@ class Theme_Editor final : public QDialog {
     QPushButton *preview_button_;
     QPushButton *preview_disabled_button_;
     QLabel *preview_disabled_label_;
+    QCheckBox *preview_in_window_check_;
+
+    /// @brief The non-modal color dialog, created on the first swatch click.
+    QColorDialog *color_dialog_ = nullptr;
+
+    /// @brief The field the color dialog is editing, and its value when the dialog was opened.
+    QColor *editing_color_ = nullptr;
+    QColor original_color_;
+
+    /// @brief Coalesces window previews while a color is being dragged.
+    QTimer *window_preview_timer_;
 
     /// @brief A reference to the theme object being actively modified by the editor.
     core::Theme &current_theme_;
@@ -63,6 +109,9 @@ class Theme_Editor final : public QDialog {
     /// @brief Maps each color picker button to its corresponding QColor in the theme.
     /// @note This allows a single slot to handle clicks from any color button.
     QMap<QPushButton *, QColor *> color_map_;
+
+    /// @brief The preview widgets to restyle when a theme field changes, keyed on the field.
+    QHash<const QColor *, QVector<Preview_Binding>> bindings_;
 };
 
 } // namespace ui
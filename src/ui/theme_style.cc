@@ -0,0 +1,217 @@
+// =================================================================================
+// ui/theme_style.cc
+// =================================================================================
+
+#include "ui/theme_style.hpp"
+
+#include <QAbstractButton>
+#include <QEvent>
+#include <QPainter>
+#include <QStyleFactory>
+#include <QStyleOption>
+#include <QWidget>
+
+namespace ui {
+
+namespace {
+
+/// @brief The bars that draw a one pixel border on the edge facing the content.
+auto bar_border_edge(const QWidget *widget) -> Qt::Edge
+{
+    const auto name = widget->objectName();
+    if (name == "title_bar") return Qt::BottomEdge;
+    if (name == "bottom_bar_widget") return Qt::TopEdge;
+    if (name == "left_bar_widget") return Qt::RightEdge;
+    return Qt::Edge{};
+}
+
+auto is_control_bar_button(const QString &name) -> bool
+{
+    return name == "login_button" || name == "add_account_button" || name == "remove_account_button";
+}
+
+} // namespace
+
+Theme_Style::Theme_Style(const core::Theme &theme)
+    : QProxyStyle{QStyleFactory::create("Fusion")}
+    , theme_{theme}
+{
+}
+
+auto Theme_Style::set_theme(const core::Theme &theme) -> void
+{
+    theme_ = theme;
+}
+
+auto Theme_Style::standardPalette() const -> QPalette
+{
+    auto palette = QPalette{};
+    palette.setColor(QPalette::Window, theme_.background_dark);
+    palette.setColor(QPalette::WindowText, theme_.text_primary);
+    palette.setColor(QPalette::Base, theme_.background_dark);
+    palette.setColor(QPalette::AlternateBase, theme_.background_light);
+    palette.setColor(QPalette::ToolTipBase, theme_.background_light);
+    palette.setColor(QPalette::ToolTipText, theme_.text_primary);
+    palette.setColor(QPalette::PlaceholderText, theme_.text_secondary);
+    palette.setColor(QPalette::Text, theme_.text_primary);
+    palette.setColor(QPalette::Button, theme_.button_primary);
+    palette.setColor(QPalette::ButtonText, theme_.text_primary);
+    palette.setColor(QPalette::BrightText, theme_.error);
+    palette.setColor(QPalette::Light, theme_.background_light);
+    palette.setColor(QPalette::Midlight, theme_.background_light);
+    palette.setColor(QPalette::Mid, theme_.border);
+    palette.setColor(QPalette::Dark, theme_.border);
+    palette.setColor(QPalette::Shadow, theme_.background_super_dark);
+    palette.setColor(QPalette::Highlight, theme_.button_hover);
+    palette.setColor(QPalette::HighlightedText, theme_.text_primary);
+    palette.setColor(QPalette::Link, theme_.accent);
+
+    palette.setColor(QPalette::Disabled, QPalette::WindowText, theme_.text_disabled);
+    palette.setColor(QPalette::Disabled, QPalette::Text, theme_.text_disabled);
+    palette.setColor(QPalette::Disabled, QPalette::ButtonText, theme_.text_disabled);
+    palette.setColor(QPalette::Disabled, QPalette::Button, theme_.button_disabled);
+
+    return palette;
+}
+
+auto Theme_Style::polish(QWidget *widget) -> void
+{
+    QProxyStyle::polish(widget);
+
+    if (qobject_cast<QAbstractButton *>(widget)) widget->setAttribute(Qt::WA_Hover);
+
+    if (bar_border_edge(widget) != Qt::Edge{}) {
+        // the bars fill with AlternateBase so they follow palette changes without a re-polish
+        widget->setBackgroundRole(QPalette::AlternateBase);
+        widget->setAutoFillBackground(true);
+        widget->installEventFilter(this);
+    }
+}
+
+auto Theme_Style::unpolish(QWidget *widget) -> void
+{
+    if (bar_border_edge(widget) != Qt::Edge{}) {
+        widget->removeEventFilter(this);
+        widget->setAutoFillBackground(false);
+        widget->setBackgroundRole(QPalette::Window);
+    }
+
+    QProxyStyle::unpolish(widget);
+}
+
+auto Theme_Style::eventFilter(QObject *watched, QEvent *event) -> bool
+{
+    if (event->type() != QEvent::Paint) return QProxyStyle::eventFilter(watched, event);
+
+    auto *widget = static_cast<QWidget *>(watched);
+    const auto rect = widget->rect();
+
+    auto painter = QPainter{widget};
+    painter.setPen(theme_.border);
+
+    switch (bar_border_edge(widget)) {
+    case Qt::TopEdge: painter.drawLine(rect.topLeft(), rect.topRight()); break;
+    case Qt::BottomEdge: painter.drawLine(rect.bottomLeft(), rect.bottomRight()); break;
+    case Qt::RightEdge: painter.drawLine(rect.topRight(), rect.bottomRight()); break;
+    default: break;
+    }
+
+    return false;
+}
+
+auto Theme_Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget) const
+    -> void
+{
+    switch (element) {
+    case PE_PanelButtonCommand: draw_button_panel(option, painter, widget); return;
+
+    case PE_PanelLineEdit:
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(theme_.border);
+        painter->setBrush(theme_.background_light);
+        painter->drawRoundedRect(QRectF{option->rect}.adjusted(0.5, 0.5, -0.5, -0.5), 3, 3);
+        painter->restore();
+        return;
+
+    case PE_FrameLineEdit: return;
+
+    case PE_PanelMenu:
+    case PE_FrameMenu:
+        painter->save();
+        painter->setPen(theme_.border);
+        painter->setBrush(element == PE_PanelMenu ? QBrush{theme_.background_light} : QBrush{Qt::NoBrush});
+        painter->drawRect(option->rect.adjusted(0, 0, -1, -1));
+        painter->restore();
+        return;
+
+    default: QProxyStyle::drawPrimitive(element, option, painter, widget);
+    }
+}
+
+auto Theme_Style::drawControl(ControlElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget) const -> void
+{
+    if (element != CE_HeaderSection) {
+        QProxyStyle::drawControl(element, option, painter, widget);
+        return;
+    }
+
+    const auto *header = qstyleoption_cast<const QStyleOptionHeader *>(option);
+    const auto rect = option->rect;
+
+    painter->save();
+    painter->fillRect(rect, theme_.background_light);
+    painter->setPen(theme_.border);
+    painter->drawLine(rect.bottomLeft(), rect.bottomRight());
+
+    const bool is_last = header && (header->position == QStyleOptionHeader::End || header->position == QStyleOptionHeader::OnlyOneSection);
+    if (!is_last) painter->drawLine(rect.topRight(), rect.bottomRight());
+    painter->restore();
+}
+
+auto Theme_Style::styleHint(StyleHint hint, const QStyleOption *option, const QWidget *widget, QStyleHintReturn *return_data) const
+    -> int
+{
+    if (hint == SH_Table_GridLineColor) return static_cast<int>(theme_.border.rgba());
+    return QProxyStyle::styleHint(hint, option, widget, return_data);
+}
+
+auto Theme_Style::draw_button_panel(const QStyleOption *option, QPainter *painter, const QWidget *widget) const -> void
+{
+    const auto name = widget ? widget->objectName() : QString{};
+    const bool enabled = option->state & State_Enabled;
+    const bool hovered = enabled && (option->state & State_MouseOver);
+    const bool pressed = enabled && (option->state & State_Sunken);
+    const auto rect = QRectF{option->rect};
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    if (name == "banner_button") {
+        constexpr qreal border_width = 3;
+        painter->setPen(QPen{hovered ? QColor{"#8f8f8f"} : theme_.accent, border_width});
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(rect.adjusted(border_width / 2, border_width / 2, -border_width / 2, -border_width / 2));
+    } else if (name == "home_button" || name == "options_button") {
+        if (hovered) {
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(theme_.button_hover);
+            painter->drawRoundedRect(rect, 5, 5);
+        }
+    } else if (is_control_bar_button(name)) {
+        if (hovered || pressed) {
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(pressed ? QColor{100, 100, 100, 30} : QColor{200, 200, 200, 30});
+            painter->drawRoundedRect(rect, 5, 5);
+        }
+    } else {
+        const auto &fill = !enabled ? theme_.button_disabled : hovered ? theme_.button_hover : theme_.button_primary;
+        painter->setPen(theme_.border);
+        painter->setBrush(fill);
+        painter->drawRoundedRect(rect.adjusted(0.5, 0.5, -0.5, -0.5), 5, 5);
+    }
+
+    painter->restore();
+}
+
+} // namespace ui
@@ -0,0 +1,70 @@
+// =================================================================================
+// ui/theme_style.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/theme.hpp"
+
+#include <QPalette>
+#include <QProxyStyle>
+
+namespace ui {
+
+/// @enum Theme_Backend
+/// @brief Defines how the theme is applied to the widgets.
+enum class Theme_Backend {
+    /// @brief A global QSS stylesheet generated from the theme.
+    Stylesheet,
+    /// @brief A Theme_Style plus a QPalette; no stylesheet engine involved.
+    Native,
+};
+
+/// @class Theme_Style
+/// @brief A Fusion-based style that draws the application's widgets straight from a core::Theme.
+///
+/// Mirrors the look of the generated stylesheet: colors go into the palette, and the
+/// elements a palette cannot express (banner buttons, flat bar buttons, bar borders,
+/// line edits and header sections) are painted here. Changing the theme only swaps
+/// the palette, so widgets are repainted but never re-polished.
+class Theme_Style final : public QProxyStyle {
+  public:
+    /// @brief Constructs the style on top of Fusion.
+    explicit Theme_Style(const core::Theme &theme);
+
+    /// @brief Replaces the theme; follow with QApplication::setPalette(standardPalette()).
+    auto set_theme(const core::Theme &theme) -> void;
+
+    /// @brief Returns the palette built from the current theme.
+    auto standardPalette() const -> QPalette override;
+
+    using QProxyStyle::polish;
+    using QProxyStyle::unpolish;
+
+    /// @brief Gives the bars an opaque background and paints their borders.
+    auto polish(QWidget *widget) -> void override;
+
+    auto unpolish(QWidget *widget) -> void override;
+
+    auto drawPrimitive(PrimitiveElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget = nullptr) const
+        -> void override;
+
+    auto drawControl(ControlElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget = nullptr) const
+        -> void override;
+
+    auto styleHint(StyleHint hint, const QStyleOption *option = nullptr, const QWidget *widget = nullptr,
+                   QStyleHintReturn *return_data = nullptr) const -> int override;
+
+  protected:
+    /// @brief Draws the border line of a bar before the bar's children paint over it.
+    auto eventFilter(QObject *watched, QEvent *event) -> bool override;
+
+  private:
+    /// @brief Draws a push button panel according to the button's object name.
+    auto draw_button_panel(const QStyleOption *option, QPainter *painter, const QWidget *widget) const -> void;
+
+  private:
+    core::Theme theme_;
+};
+
+} // namespace ui
@@ -0,0 +1,121 @@
+// =================================================================================
+// ui/thumbnail_cache.cc
+// =================================================================================
+
+#include "ui/thumbnail_cache.hpp"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace ui {
+
+static_assert(std::endian::native == std::endian::little, "the thumbnail format is little-endian");
+
+static constexpr std::uint32_t THUMBNAIL_MAGIC = 0x4D485446; // "FTHM"
+static constexpr std::uint32_t THUMBNAIL_VERSION = 1;
+
+/// @brief Thumbnails are stored in the format Qt paints fastest, so a hit needs no conversion.
+static constexpr auto THUMBNAIL_FORMAT = QImage::Format_ARGB32_Premultiplied;
+static constexpr auto THUMBNAIL_FORMAT_ID = static_cast<std::uint32_t>(THUMBNAIL_FORMAT);
+
+/// @brief The fixed header at the start of every thumbnail file, followed by the scanlines.
+struct Thumbnail_Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t bytes_per_line;
+    std::uint32_t format;
+};
+static_assert(sizeof(Thumbnail_Header) == 24);
+
+static auto cache_path_for(std::uint64_t source_hash, const QSize &size, qreal device_pixel_ratio) -> QString
+{
+    const auto directory = QDir{QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/thumbnails"};
+    if (!directory.exists() && !directory.mkpath(".")) return {};
+
+    const auto name = QString{"%1-%2x%3@%4.thumb"}
+                          .arg(static_cast<qulonglong>(source_hash), 16, 16, QChar{'0'})
+                          .arg(size.width())
+                          .arg(size.height())
+                          .arg(qRound(device_pixel_ratio * 100));
+    return directory.absoluteFilePath(name);
+}
+
+static auto read_thumbnail(const QString &path) -> QImage
+{
+    auto file = QFile{path};
+    if (!file.open(QIODevice::ReadOnly)) return {};
+
+    const auto bytes = file.readAll();
+    if (bytes.size() < static_cast<qsizetype>(sizeof(Thumbnail_Header))) return {};
+
+    Thumbnail_Header header;
+    std::memcpy(&header, bytes.constData(), sizeof(header));
+    if (header.magic != THUMBNAIL_MAGIC || header.version != THUMBNAIL_VERSION || header.format != THUMBNAIL_FORMAT_ID) return {};
+
+    auto image = QImage{static_cast<int>(header.width), static_cast<int>(header.height), THUMBNAIL_FORMAT};
+    if (image.isNull() || static_cast<std::uint32_t>(image.bytesPerLine()) != header.bytes_per_line) return {};
+    if (bytes.size() != static_cast<qsizetype>(sizeof(header)) + image.sizeInBytes()) return {};
+
+    std::memcpy(image.bits(), bytes.constData() + sizeof(header), static_cast<std::size_t>(image.sizeInBytes()));
+    return image;
+}
+
+static auto write_thumbnail(const QString &path, const QImage &image) -> void
+{
+    const auto header = Thumbnail_Header{
+        .magic = THUMBNAIL_MAGIC,
+        .version = THUMBNAIL_VERSION,
+        .width = static_cast<std::uint32_t>(image.width()),
+        .height = static_cast<std::uint32_t>(image.height()),
+        .bytes_per_line = static_cast<std::uint32_t>(image.bytesPerLine()),
+        .format = THUMBNAIL_FORMAT_ID,
+    };
+
+    auto file = QSaveFile{path};
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    file.commit();
+}
+
+auto load_thumbnail(const core::Asset &source, const QSize &size, qreal device_pixel_ratio) -> QImage
+{
+    if (source.data.isEmpty()) return {};
+
+    const auto cache_path = cache_path_for(source.hash, size, device_pixel_ratio);
+    auto image = cache_path.isEmpty() ? QImage{} : read_thumbnail(cache_path);
+
+    if (image.isNull()) {
+        auto buffer = QBuffer{};
+        buffer.setData(source.data);
+
+        auto reader = QImageReader{&buffer};
+        reader.setAutoTransform(true);
+        image = reader.read();
+        if (image.isNull()) return {};
+
+        const auto target = (QSizeF{size} * device_pixel_ratio).toSize();
+        if (image.width() > target.width() || image.height() > target.height()) {
+            image = image.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+        image = image.convertToFormat(THUMBNAIL_FORMAT);
+
+        if (!cache_path.isEmpty()) write_thumbnail(cache_path, image);
+    }
+
+    image.setDevicePixelRatio(device_pixel_ratio);
+    return image;
+}
+
+} // namespace ui
@@ -0,0 +1,25 @@
+// =================================================================================
+// ui/thumbnail_cache.hpp
+// =================================================================================
+
+#pragma once
+
+#include "core/asset_pack.hpp"
+
+#include <QImage>
+#include <QSize>
+
+namespace ui {
+
+/// @brief Returns an asset image scaled to fit inside a size, reading a cached copy when there is one.
+///
+/// Scaled images are kept uncompressed under "thumbnails" in the app data directory,
+/// keyed on the asset's content hash, the target size and the device pixel ratio. A
+/// hit is a plain read and copy that never touches the asset data; only a miss
+/// decodes and scales the source. Images are never scaled up. The result has the
+/// given device pixel ratio set.
+///
+/// @note Only uses QImage and files, so it may run on a worker thread.
+auto load_thumbnail(const core::Asset &source, const QSize &size, qreal device_pixel_ratio) -> QImage;
+
+} // namespace ui
@@ -8,6 +8,7 @@
 #include <QIcon>
 #include <QLabel>
 #include <QMainWindow>
+#include <QWindow>
 
 namespace ui {
 
@@ -19,6 +20,8 @@ Title_Bar::Title_Bar(QWidget *parent, const QString &title)
     , close_button_{new QPushButton{"", this}}
     , mouse_click_position_{}
     , window_position_{}
+    , system_move_enabled_{true}
+    , manual_move_active_{false}
 {
     setObjectName("title_bar");
     setFixedHeight(40);
@@ -32,17 +35,27 @@ void Title_Bar::set_home_button_visible(bool visible)
     home_button_->setVisible(visible);
 }
 
+void Title_Bar::set_system_move_enabled(bool enabled)
+{
+    system_move_enabled_ = enabled;
+}
+
 void Title_Bar::mousePressEvent(QMouseEvent *event)
 {
-    if (event->button() == Qt::LeftButton) {
-        window_position_ = QWidget::window()->pos();
-        mouse_click_position_ = event->globalPosition();
-    }
+    if (event->button() != Qt::LeftButton) return;
+
+    // the compositor drives the move; we only see the final position
+    auto *handle = QWidget::window()->windowHandle();
+    manual_move_active_ = !(system_move_enabled_ && handle && handle->startSystemMove());
+    if (!manual_move_active_) return;
+
+    window_position_ = QWidget::window()->pos();
+    mouse_click_position_ = event->globalPosition();
 }
 
 void Title_Bar::mouseMoveEvent(QMouseEvent *event)
 {
-    if (event->buttons() & Qt::LeftButton) {
+    if (manual_move_active_ && (event->buttons() & Qt::LeftButton)) {
         const QPointF delta = event->globalPosition() - mouse_click_position_;
         QWidget::window()->move(window_position_ + delta.toPoint());
     }
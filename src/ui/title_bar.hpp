@@ -23,6 +23,9 @@ class Title_Bar final : public QWidget {
     /// @brief Sets the visibility of the home/back button.
     auto set_home_button_visible(bool visible) -> void;
 
+    /// @brief Lets the windowing system move the window on drags instead of following the mouse by hand.
+    auto set_system_move_enabled(bool enabled) -> void;
+
   signals:
     /// @brief Emitted when the home/back button is clicked.
     auto home_button_clicked() -> void;
@@ -49,6 +52,8 @@ class Title_Bar final : public QWidget {
     // used for window dragging
     QPoint window_position_;
     QPointF mouse_click_position_;
+    bool system_move_enabled_;
+    bool manual_move_active_;
 };
 
 } // namespace ui
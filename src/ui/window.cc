@@ -6,36 +6,60 @@
 
 #include "central_widget.hpp"
 #include "core/account.hpp"
+#include "core/account_export.hpp"
+#include "core/account_import.hpp"
+#include "core/asset_pack.hpp"
+#include "core/stylesheet_template.hpp"
 #include "ui/add_account_dialog.hpp"
-#include "ui/password_table_widget.hpp"
 #include "ui/theme_editor.hpp"
+#include "ui/thumbnail_cache.hpp"
 
 #include <QCoreApplication>
-#include <QDebug>
 #include <QDesktopServices>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileDialog>
+#include <QGuiApplication>
+#include <QLoggingCategory>
 #include <QMessageBox>
+#include <QMetaObject>
+#include <QProgressDialog>
 #include <QResizeEvent>
 #include <QScreen>
 #include <QStandardPaths>
 #include <QStyle>
+#include <QStyleFactory>
 #include <QTextStream>
 #include <QVBoxLayout>
+#include <QWindow>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
 
 namespace ui {
 
+/// @brief The fixed height of every accounts table row, so the view never measures rows.
+static constexpr int ACCOUNT_ROW_HEIGHT = 30;
+
+/// @brief How long the window size has to stay unchanged before the banners are rescaled smoothly.
+static constexpr int BANNER_SETTLE_DELAY_MS = 100;
+
+/// @brief Times every theme application per backend; off by default, enable with
+/// QT_LOGGING_RULES="friede.theme.timing.debug=true" to compare the native and stylesheet paths.
+Q_LOGGING_CATEGORY(theme_timing, "friede.theme.timing", QtInfoMsg)
+
 Window::Window(QWidget *parent)
     : QMainWindow{parent}
     , main_stacked_widget_{new QStackedWidget{this}}
     , home_page_{new QWidget{}}
     , home_page_layout_{new QHBoxLayout{home_page_}}
     , accounts_page_{new QWidget{}}
-    , accounts_table_{new QTableWidget{0, 3}}
+    , account_search_edit_{new QLineEdit{}}
+    , accounts_table_{new QTableView{}}
+    , accounts_model_{new Accounts_Table_Model{account_store_, this}}
     , progress_page_{new QWidget{}}
     , progress_status_label_{new QLabel{"Initializing..."}}
     , progress_back_button_{new QPushButton{"back"}}
@@ -45,11 +69,19 @@ Window::Window(QWidget *parent)
     , control_bar_{new Control_Bar{this}}
     , updater_{new Updater{this}}
     , theme_config_{new core::Theme_Config{}}
+    , theme_service_{new core::Theme_Service{theme_config_, this}}
+    , theme_backend_{Theme_Backend::Stylesheet}
+    , stylesheet_palette_{QApplication::palette()}
     , account_config_{new core::Account_Config{}}
+    , account_store_{new core::Account_Store{account_config_, this}}
     , window_size_{}
     , mouse_click_position_{}
-    , banners_dir_{QCoreApplication::applicationDirPath() + "/banners/"}
-    , game_icons_dir_{QCoreApplication::applicationDirPath() + "/icons/"}
+    , system_window_drag_{true}
+    , resize_drag_active_{false}
+    , system_resize_active_{false}
+    , pending_geometry_{}
+    , geometry_update_timer_{new QTimer{this}}
+    , banner_settle_timer_{new QTimer{this}}
 {
     auto *worker = new Login_Worker{};
     worker->moveToThread(&worker_thread_);
@@ -112,7 +144,7 @@ Window::Window(QWidget *parent)
 
     main_window_layout->addWidget(right_column_widget);
 
-    auto *central_widget = new Central_Widget{theme_config_, this};
+    auto *central_widget = new Central_Widget{theme_service_, this};
     central_widget->setObjectName("central_widget");
     central_widget->setLayout(main_window_layout);
     QMainWindow::setCentralWidget(central_widget);
@@ -123,22 +155,48 @@ Window::Window(QWidget *parent)
     QMainWindow::connect(title_bar_, &Title_Bar::home_button_clicked, this, &Window::handle_home_button_click);
 
     QMainWindow::connect(misc_bar_, &Misc_Bar::customize_theme_requested, this, &Window::handle_customize_theme_button_click);
+    QMainWindow::connect(misc_bar_, &Misc_Bar::native_theme_toggled, this,
+                         [this](bool native) { set_theme_backend(native ? Theme_Backend::Native : Theme_Backend::Stylesheet); });
+    QMainWindow::connect(misc_bar_, &Misc_Bar::system_window_drag_toggled, this, &Window::set_system_window_drag);
     QMainWindow::connect(misc_bar_, &Misc_Bar::check_for_updates_requested, updater_, &Updater::check_for_updates);
     QMainWindow::connect(misc_bar_, &Misc_Bar::open_config_directory_requested, this, [this] {
         const QString config_dir = account_config_->get_config_directory_path();
         QDesktopServices::openUrl(QUrl::fromLocalFile(config_dir));
     });
 
+    QMainWindow::connect(misc_bar_, &Misc_Bar::import_accounts_requested, this, &Window::handle_import_accounts_request);
+    QMainWindow::connect(misc_bar_, &Misc_Bar::export_accounts_requested, this, &Window::handle_export_accounts_request);
+
     QMainWindow::connect(control_bar_, &Control_Bar::login_clicked, this, &Window::handle_login_button_click);
     QMainWindow::connect(control_bar_, &Control_Bar::add_account_clicked, this, &Window::handle_add_account_button_click);
     QMainWindow::connect(control_bar_, &Control_Bar::remove_account_clicked, this, &Window::handle_remove_account_button_click);
 
+    QMainWindow::connect(account_store_, &core::Account_Store::flush_failed, this,
+                         [this] { QMessageBox::critical(this, "Save Error", "Failed to save account changes to the configuration file"); });
+
+    QMainWindow::connect(theme_service_, &core::Theme_Service::theme_changed, this, &Window::apply_theme);
+
+    geometry_update_timer_->setSingleShot(true);
+    QMainWindow::connect(geometry_update_timer_, &QTimer::timeout, this, &Window::apply_pending_geometry);
+
+    banner_settle_timer_->setSingleShot(true);
+    banner_settle_timer_->setInterval(BANNER_SETTLE_DELAY_MS);
+    QMainWindow::connect(banner_settle_timer_, &QTimer::timeout, this, [this] {
+        // a system resize sends no release; it is over once the size settles without the button held
+        if (system_resize_active_ && !(QGuiApplication::mouseButtons() & Qt::LeftButton)) {
+            system_resize_active_ = false;
+            resize_drag_active_ = false;
+        }
+        update_banner_sizes(Qt::SmoothTransformation);
+    });
+
     apply_theme();
     updater_->check_for_updates();
 }
 
 Window::~Window()
 {
+    task_pool_.waitForDone();
     worker_thread_.quit();
     worker_thread_.wait();
 }
@@ -146,6 +204,19 @@ Window::~Window()
 auto Window::resizeEvent(QResizeEvent *event) -> void
 {
     QMainWindow::resizeEvent(event);
+
+    // while dragging, scale cheaply and leave the smooth pass until the size settles
+    if (resize_drag_active_) {
+        update_banner_sizes(Qt::FastTransformation);
+        banner_settle_timer_->start();
+    } else {
+        banner_settle_timer_->stop();
+        update_banner_sizes(Qt::SmoothTransformation);
+    }
+}
+
+auto Window::update_banner_sizes(Qt::TransformationMode mode) -> void
+{
     home_page_layout_->blockSignals(true);
 
     const int available_content_height = height() - title_bar_->height() - control_bar_->height();
@@ -195,16 +266,18 @@ auto Window::resizeEvent(QResizeEvent *event) -> void
         if (riot::is_game_index_out_of_range(i)) continue;
         const auto current_game = static_cast<riot::Game>(i);
 
-        const auto original_pixmap = banner_pixmaps_[current_game];
-        if (original_pixmap.isNull()) continue;
+        const auto banner_size = QSize{desired_banner_width, desired_banner_height};
+        const auto &pyramid = banner_pyramids_[current_game];
 
-        const auto banner_width = desired_banner_width;
-        const auto banner_height = desired_banner_height;
-        const auto scaled_pixmap = original_pixmap.scaled(banner_width, banner_height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        button->setIcon(QIcon{scaled_pixmap});
+        // a banner that is still decoding keeps its slot at the size it will have
+        auto image_display_size = banner_size;
+        if (!pyramid.is_null()) {
+            const auto scaled_pixmap = pyramid.scaled(banner_size, mode);
+            button->setIcon(QIcon{scaled_pixmap});
 
-        const auto image_display_size = scaled_pixmap.size();
-        button->setIconSize(image_display_size);
+            image_display_size = scaled_pixmap.size();
+            button->setIconSize(image_display_size);
+        }
 
         constexpr int image_border_padding = 2;
         const auto button_width = image_display_size.width() + (2 * image_border_padding);
@@ -218,8 +291,7 @@ auto Window::resizeEvent(QResizeEvent *event) -> void
 auto Window::keyPressEvent(QKeyEvent *event) -> void
 {
     if (event->key() == Qt::Key_Escape) {
-        const bool account_table_empty = accounts_table_->selectedItems().isEmpty();
-        if (!account_table_empty) reset_account_selection();
+        if (accounts_table_->selectionModel()->hasSelection()) reset_account_selection();
     }
     QMainWindow::keyPressEvent(event);
 }
@@ -227,6 +299,8 @@ auto Window::keyPressEvent(QKeyEvent *event) -> void
 // TODO clean this function up
 auto Window::mouseMoveEvent(QMouseEvent *event) -> void
 {
+    if (system_resize_active_) return;
+
     if (event->buttons() == Qt::LeftButton) {
         constexpr int resize_margin = 8;
 
@@ -238,7 +312,6 @@ auto Window::mouseMoveEvent(QMouseEvent *event) -> void
         const bool on_right_edge = x >= size.width() - resize_margin;
         const bool on_bottom_edge = y >= size.height() - resize_margin;
 
-        // FIXME the images are a bit jittery for left / up movement due to our moving with resize calculations
         const bool is_resizing = on_left_edge || on_right_edge || on_top_edge || on_bottom_edge;
         if (is_resizing) {
             QRect new_size = {size};
@@ -276,23 +349,89 @@ auto Window::mouseMoveEvent(QMouseEvent *event) -> void
                 }
             }
 
-            QMainWindow::setGeometry(new_size);
+            resize_drag_active_ = true;
+            pending_geometry_ = new_size;
+            if (!geometry_update_timer_->isActive()) apply_pending_geometry();
         }
     }
 }
 
+auto Window::apply_pending_geometry() -> void
+{
+    if (pending_geometry_.isNull() || pending_geometry_ == QMainWindow::geometry()) return;
+
+    QMainWindow::setGeometry(pending_geometry_);
+
+    const auto *current_screen = QMainWindow::screen();
+    const auto refresh_rate = current_screen ? current_screen->refreshRate() : 60.0;
+    geometry_update_timer_->start(std::max(1, static_cast<int>(1000.0 / refresh_rate)));
+}
+
 auto Window::mousePressEvent(QMouseEvent *event) -> void
 {
-    if (event->button() == Qt::LeftButton) {
-        grabMouse();
-        window_size_ = QMainWindow::geometry();
-        mouse_click_position_ = event->pos();
+    if (event->button() != Qt::LeftButton) return;
+
+    // a new press means any earlier drag is over, even a system resize that never changed the size
+    resize_drag_active_ = false;
+    system_resize_active_ = false;
+
+    if (system_window_drag_) {
+        const auto edges = resize_edges_at(event->pos());
+        auto *handle = QMainWindow::windowHandle();
+
+        // the compositor drives the resize; we only see the resulting resize events, so the
+        // settle timer is armed right away to end the drag even if the size never changes
+        if (edges && handle && handle->startSystemResize(edges)) {
+            resize_drag_active_ = true;
+            system_resize_active_ = true;
+            banner_settle_timer_->start();
+            return;
+        }
     }
+
+    grabMouse();
+    window_size_ = QMainWindow::geometry();
+    mouse_click_position_ = event->pos();
+}
+
+auto Window::resize_edges_at(const QPoint &position) const -> Qt::Edges
+{
+    constexpr int resize_margin = 8;
+
+    Qt::Edges edges;
+    if (position.y() <= resize_margin) edges |= Qt::TopEdge;
+    if (position.x() <= resize_margin) edges |= Qt::LeftEdge;
+    if (position.x() >= width() - resize_margin) edges |= Qt::RightEdge;
+    if (position.y() >= height() - resize_margin) edges |= Qt::BottomEdge;
+    return edges;
+}
+
+auto Window::set_system_window_drag(bool enabled) -> void
+{
+    system_window_drag_ = enabled;
+    title_bar_->set_system_move_enabled(enabled);
 }
 
 auto Window::mouseReleaseEvent(QMouseEvent *event) -> void
 {
-    if (event->button() == Qt::LeftButton) releaseMouse();
+    if (event->button() != Qt::LeftButton) return;
+
+    releaseMouse();
+
+    // the windowing system usually swallows the release of its own resize, but one may still get here
+    if (system_resize_active_) {
+        system_resize_active_ = false;
+        resize_drag_active_ = false;
+        return;
+    }
+
+    if (!resize_drag_active_) return;
+
+    apply_pending_geometry();
+    geometry_update_timer_->stop();
+
+    resize_drag_active_ = false;
+    pending_geometry_ = {};
 }
 
 auto Window::on_login_progress_update(const QString &message) -> void
@@ -306,181 +445,202 @@ auto Window::on_login_finished(bool success, const QString &message) -> void
     progress_back_button_->show();
 
     if (success) {
-        progress_status_label_->setStyleSheet(QString("color: %1; font-weight: bold;").arg(theme_config_->load().success.name()));
+        progress_status_label_->setStyleSheet(QString("color: %1; font-weight: bold;").arg(theme_service_->theme().success.name()));
     } else {
-        progress_status_label_->setStyleSheet(QString("color: %1; font-weight: bold;").arg(theme_config_->load().error.name()));
+        progress_status_label_->setStyleSheet(QString("color: %1; font-weight: bold;").arg(theme_service_->theme().error.name()));
     }
 }
 
 auto Window::refresh_accounts_table() -> void
 {
-    accounts_table_->blockSignals(true);
+    const auto query = account_search_edit_->text();
+    accounts_model_->set_query(query);
 
-    accounts_table_->setRowCount(0);
-    accounts_cache_ = account_config_->get_accounts();
+    // search results keep their ranking, so the table stays unsorted while filtering;
+    // enabling sorting re-sorts, so it is only toggled when the mode actually changes
+    const bool sortable = query.trimmed().isEmpty();
+    if (accounts_table_->isSortingEnabled() != sortable) accounts_table_->setSortingEnabled(sortable);
 
-    for (const auto &account : accounts_cache_) {
-        const int row = accounts_table_->rowCount();
-        accounts_table_->insertRow(row);
-        accounts_table_->setItem(row, 0, new QTableWidgetItem{account.note});
-        accounts_table_->setItem(row, 1, new QTableWidgetItem{account.username});
-
-        auto *password_item = new Password_Table_Widget{};
-        password_item->setData(Qt::DisplayRole, QString("************"));
-        password_item->setData(Qt::UserRole, account.password);
-        accounts_table_->setItem(row, 2, password_item);
-    }
-
-    accounts_table_->blockSignals(false);
     handle_table_selection_changed();
 }
 
 // FIXME item border is 1 pixel off on the right, making that specific border thicker
 auto Window::generate_stylesheet(const core::Theme &theme) -> QString
 {
-    const auto stylesheet_template =
-        QString{"QMainWindow, QDialog, QWidget#central_widget, QWidget#home_page, "
-                "QWidget#accounts_page, QWidget#progress_page {"
-                "    background-color: %1;"
-                "    color: %2;"
-                "}"
-                "QWidget#central_widget {"
-                "    background-color: transparent;"
-                "}"
-                "QWidget#title_bar {"
-                "    background-color: %8;"
-                "    border-bottom: 1px solid %3;"
-                "}"
-                "QWidget#bottom_bar_widget {"
-                "    background-color: %8;"
-                "    border-top: 1px solid %3;"
-                "}"
-                "QWidget#left_bar_widget {"
-                "    background-color: %8;"
-                "    border-right: 1px solid %3;"
-                "}"
-                "QMenu {"
-                "    background-color: %8;"
-                "    color: %2;"
-                "    border: 1px solid %3;"
-                "}"
-                "QMenu::item {"
-                "    padding: 4px 20px;"
-                "}"
-                "QMenu::item:selected {"
-                "    background-color: %5;"
-                "}"
-                "QPushButton {"
-                "    background-color: %4;"
-                "    color: %2;"
-                "    border: 1px solid %3;"
-                "    padding: 5px 15px;"
-                "    border-radius: 5px;"
-                "}"
-                "QPushButton:hover {"
-                "    background-color: %5;"
-                "}"
-                "QPushButton:disabled {"
-                "    background-color: %6;"
-                "    color: %7;"
-                "    border: 1px solid %3;"
-                "}"
-                "QPushButton#banner_button {"
-                "    background-color: transparent;"
-                "    border: 3px solid %9;"
-                "    padding: 0px;"
-                "}"
-                "QPushButton#banner_button:hover {"
-                "    border-color: #8f8f8f;"
-                "}"
-                "QPushButton#home_button, QPushButton#options_button {"
-                "    background-color: transparent;"
-                "    border: none;"
-                "    padding: 2px;"
-                "}"
-                "QPushButton#home_button:hover, QPushButton#options_button:hover {"
-                "    background-color: %5;"
-                "}"
-                "QPushButton#options_button::menu-indicator {"
-                "    image: none;"
-                "    width: 0px;"
-                "}"
-                "QPushButton#login_button, QPushButton#add_account_button, QPushButton#remove_account_button {"
-                "    background-color: transparent;"
-                "    border: none;"
-                "}"
-                "QPushButton#login_button:hover, QPushButton#add_account_button:hover, QPushButton#remove_account_button:hover {"
-                "    background-color: rgba(200, 200, 200, 30);"
-                "}"
-                "QPushButton#login_button:pressed, QPushButton#add_account_button:pressed, QPushButton#remove_account_button:pressed {"
-                "  background-color: rgba(100, 100, 100, 30);"
-                "}"
-                "QTableWidget {"
-                "    background-color: %1;"
-                "    border: 1px solid %3;"
-                "    gridline-color: %3;"
-                "}"
-                "QTableWidget::item {"
-                "    color: %2;"
-                "    border: none;"
-                "}"
-                "QTableWidget::item:selected {"
-                "    background-color: %5;"
-                "    color: %2;"
-                "}"
-                "QHeaderView::section {"
-                "    background-color: %8;"
-                "    color: %2;"
-                "    padding: 4px;"
-                "    border: none;"
-                "    border-bottom: 1px solid %3;"
-                "    border-right: 1px solid %3;"
-                "}"
-                "QHeaderView::section:last {"
-                "    border-right: none;"
-                "}"
-                "QLineEdit {"
-                "    background-color: %8;"
-                "    color: %2;"
-                "    border: 1px solid %3;"
-                "    padding: 5px;"
-                "    border-radius: 3px;"
-                "}"
-                "QPushButton, QLineEdit, QTableWidget, QHeaderView {"
-                "    outline: none;"
-                "}"};
-
-    return stylesheet_template.arg(theme.background_dark.name(),  // %1
-                                   theme.text_primary.name(),     // %2
-                                   theme.border.name(),           // %3
-                                   theme.button_primary.name(),   // %4
-                                   theme.button_hover.name(),     // %5
-                                   theme.button_disabled.name(),  // %6
-                                   theme.text_disabled.name(),    // %7
-                                   theme.background_light.name(), // %8
-                                   theme.accent.name()            // %9
-    );
+    static const auto stylesheet_template = core::Stylesheet_Template{
+        "QMainWindow, QDialog, QWidget#central_widget, QWidget#home_page, "
+        "QWidget#accounts_page, QWidget#progress_page {"
+        "    background-color: ${background_dark};"
+        "    color: ${text_primary};"
+        "}"
+        "QWidget#central_widget {"
+        "    background-color: transparent;"
+        "}"
+        "QWidget#title_bar {"
+        "    background-color: ${background_light};"
+        "    border-bottom: 1px solid ${border};"
+        "}"
+        "QWidget#bottom_bar_widget {"
+        "    background-color: ${background_light};"
+        "    border-top: 1px solid ${border};"
+        "}"
+        "QWidget#left_bar_widget {"
+        "    background-color: ${background_light};"
+        "    border-right: 1px solid ${border};"
+        "}"
+        "QMenu {"
+        "    background-color: ${background_light};"
+        "    color: ${text_primary};"
+        "    border: 1px solid ${border};"
+        "}"
+        "QMenu::item {"
+        "    padding: 4px 20px;"
+        "}"
+        "QMenu::item:selected {"
+        "    background-color: ${button_hover};"
+        "}"
+        "QPushButton {"
+        "    background-color: ${button_primary};"
+        "    color: ${text_primary};"
+        "    border: 1px solid ${border};"
+        "    padding: 5px 15px;"
+        "    border-radius: 5px;"
+        "}"
+        "QPushButton:hover {"
+        "    background-color: ${button_hover};"
+        "}"
+        "QPushButton:disabled {"
+        "    background-color: ${button_disabled};"
+        "    color: ${text_disabled};"
+        "    border: 1px solid ${border};"
+        "}"
+        "QPushButton#banner_button {"
+        "    background-color: transparent;"
+        "    border: 3px solid ${accent};"
+        "    padding: 0px;"
+        "}"
+        "QPushButton#banner_button:hover {"
+        "    border-color: #8f8f8f;"
+        "}"
+        "QPushButton#home_button, QPushButton#options_button {"
+        "    background-color: transparent;"
+        "    border: none;"
+        "    padding: 2px;"
+        "}"
+        "QPushButton#home_button:hover, QPushButton#options_button:hover {"
+        "    background-color: ${button_hover};"
+        "}"
+        "QPushButton#options_button::menu-indicator {"
+        "    image: none;"
+        "    width: 0px;"
+        "}"
+        "QPushButton#login_button, QPushButton#add_account_button, QPushButton#remove_account_button {"
+        "    background-color: transparent;"
+        "    border: none;"
+        "}"
+        "QPushButton#login_button:hover, QPushButton#add_account_button:hover, QPushButton#remove_account_button:hover {"
+        "    background-color: rgba(200, 200, 200, 30);"
+        "}"
+        "QPushButton#login_button:pressed, QPushButton#add_account_button:pressed, QPushButton#remove_account_button:pressed {"
+        "  background-color: rgba(100, 100, 100, 30);"
+        "}"
+        "QTableView {"
+        "    background-color: ${background_dark};"
+        "    border: 1px solid ${border};"
+        "    gridline-color: ${border};"
+        "}"
+        "QTableView::item {"
+        "    color: ${text_primary};"
+        "    border: none;"
+        "}"
+        "QTableView::item:selected {"
+        "    background-color: ${button_hover};"
+        "    color: ${text_primary};"
+        "}"
+        "QHeaderView::section {"
+        "    background-color: ${background_light};"
+        "    color: ${text_primary};"
+        "    padding: 4px;"
+        "    border: none;"
+        "    border-bottom: 1px solid ${border};"
+        "    border-right: 1px solid ${border};"
+        "}"
+        "QHeaderView::section:last {"
+        "    border-right: none;"
+        "}"
+        "QLineEdit {"
+        "    background-color: ${background_light};"
+        "    color: ${text_primary};"
+        "    border: 1px solid ${border};"
+        "    padding: 5px;"
+        "    border-radius: 3px;"
+        "}"
+        "QPushButton, QLineEdit, QTableView, QHeaderView {"
+        "    outline: none;"
+        "}"};
+
+    // previews change with every color pick and are not worth a cache write
+    if (theme_service_->is_previewing()) return stylesheet_template.render(theme);
+
+    const auto cache_path = QDir{theme_config_->get_config_directory_path()}.absoluteFilePath("stylesheet.qss");
+    return stylesheet_template.render_cached(theme, cache_path);
 }
 
 auto Window::apply_theme() -> void
 {
-    const auto theme = theme_config_->load();
-    const auto stylesheet = generate_stylesheet(theme);
+    auto timer = QElapsedTimer{};
+    timer.start();
+
+    const auto &theme = theme_service_->theme();
+    auto *native_style = dynamic_cast<Theme_Style *>(QApplication::style());
+
+    if (theme_backend_ == Theme_Backend::Native) {
+        QMainWindow::setStyleSheet({});
+
+        // the style is installed once; later theme changes only swap the palette
+        if (native_style) {
+            native_style->set_theme(theme);
+        } else {
+            native_style = new Theme_Style{theme};
+            QApplication::setStyle(native_style);
+        }
+        QApplication::setPalette(native_style->standardPalette());
+        QMainWindow::update();
+    } else {
+        if (native_style) {
+            QApplication::setStyle(QStyleFactory::create("Fusion"));
+            QApplication::setPalette(stylesheet_palette_);
+        }
+        QMainWindow::setStyleSheet(generate_stylesheet(theme));
+    }
+
+    qCDebug(theme_timing).nospace() << (theme_backend_ == Theme_Backend::Native ? "native" : "stylesheet")
+                                    << " backend applied the theme in " << timer.nsecsElapsed() / 1000 << " us";
+}
+
+auto Window::set_theme_backend(Theme_Backend backend) -> void
+{
+    if (backend == theme_backend_) return;
 
-    QMainWindow::setStyleSheet(stylesheet);
+    theme_backend_ = backend;
+    apply_theme();
 }
 
 auto Window::handle_customize_theme_button_click() -> void
 {
-    auto theme = theme_config_->load();
+    auto theme = theme_service_->theme();
     auto editor = Theme_Editor{theme, this};
 
+    QMainWindow::connect(&editor, &Theme_Editor::preview_requested, theme_service_, &core::Theme_Service::preview);
+    QMainWindow::connect(&editor, &Theme_Editor::preview_reverted, theme_service_, &core::Theme_Service::revert);
+
     if (editor.exec() == QDialog::Accepted) {
-        if (theme_config_->save(theme)) {
-            apply_theme();
-        } else {
+        if (!theme_service_->save(theme)) {
+            theme_service_->revert();
             QMessageBox::critical(this, "Theme Error", "Failed to save the updated theme");
         }
+    } else {
+        theme_service_->revert();
     }
 }
 
@@ -509,14 +669,14 @@ auto Window::handle_game_banner_click(riot::Game game) -> void
 
 auto Window::handle_table_selection_changed() -> void
 {
-    const bool row_is_selected = !accounts_table_->selectedItems().isEmpty();
+    const bool row_is_selected = accounts_table_->selectionModel()->hasSelection();
     control_bar_->set_controls_enabled(row_is_selected);
 }
 
 auto Window::handle_login_button_click() -> void
 {
-    const int row = accounts_table_->currentRow();
-    if (row == -1) return;
+    const auto account = account_store_->find(accounts_model_->id_at(accounts_table_->currentIndex().row()));
+    if (!account) return;
 
     misc_bar_->hide();
     control_bar_->hide();
@@ -534,14 +694,15 @@ auto Window::handle_login_button_click() -> void
     }
 
     if (!icon_filename.isEmpty()) {
-        const auto game_icon_pixmap = QPixmap(game_icons_dir_ + icon_filename);
-        progress_game_icon_label_->setPixmap(game_icon_pixmap.scaled(128, 128, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        const auto icon_asset = core::Asset_Pack::application().find(("icons/" + icon_filename).toStdString());
+        const auto game_icon = load_thumbnail(icon_asset, QSize{128, 128}, devicePixelRatioF());
+        progress_game_icon_label_->setPixmap(QPixmap::fromImage(game_icon));
     }
 
     main_stacked_widget_->setCurrentIndex(static_cast<int>(Page::Progress));
 
-    const auto username = accounts_table_->item(row, 1)->text();
-    const auto password = accounts_table_->item(row, 2)->data(Qt::UserRole).toString();
+    const auto username = account->username.toString();
+    const auto password = account->password.toString();
 
     reset_account_selection();
     emit start_login(current_game_, username, password);
@@ -560,62 +721,96 @@ auto Window::handle_add_account_button_click() -> void
             return;
         }
 
-        if (account_config_->add_account(new_account)) {
-            refresh_accounts_table();
-            accounts_table_->setCurrentCell(accounts_table_->rowCount() - 1, 0);
-        } else {
-            QMessageBox::critical(this, "Add Account", "Failed to save the new account");
-        }
+        // the model picks the new row up from the store, so the table keeps its scroll position
+        const auto id = account_store_->add(new_account);
+        select_account(id);
     }
 }
 
 auto Window::handle_remove_account_button_click() -> void
 {
-    const int current_row = accounts_table_->currentRow();
-    if (current_row == -1) {
+    const auto id = accounts_model_->id_at(accounts_table_->currentIndex().row());
+    const auto account_to_delete = account_store_->find(id);
+    if (!account_to_delete) {
         QMessageBox::warning(this, "Delete Account", "Please select an account to delete");
         return;
     }
 
-    const auto &account_to_delete = accounts_cache_[current_row];
-    const auto confirmation = QString{"Are you sure you want to delete '%1'?"}.arg(account_to_delete.username);
+    const auto confirmation = QString{"Are you sure you want to delete '%1'?"}.arg(account_to_delete->username.toString());
     const auto reply = QMessageBox::warning(this, "Confirm Deletion", confirmation, QMessageBox::Yes | QMessageBox::No);
     if (reply == QMessageBox::No) return;
 
-    if (account_config_->remove_account(current_row)) {
-        refresh_accounts_table();
+    if (account_store_->remove(id)) {
+        handle_table_selection_changed();
     } else {
-        QMessageBox::critical(this, "Deletion Error", "Failed to remove the account from the configuration file");
+        QMessageBox::critical(this, "Deletion Error", "Failed to remove the account");
     }
 }
 
-auto Window::handle_account_cell_updated(int row, int column) -> void
+auto Window::handle_import_accounts_request() -> void
 {
-    if (row < 0 || row >= accounts_cache_.size()) return;
-    auto updated_account = accounts_cache_[row];
+    const auto path = QFileDialog::getOpenFileName(this, "Import Accounts", QDir::homePath(), "Accounts (*.csv *.json *.toml)");
+    if (path.isEmpty()) return;
+
+    auto *progress = new QProgressDialog{"Importing accounts...", QString{}, 0, 100, this};
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setValue(0);
+
+    // parsing runs off the UI thread; the store is only touched once it is done
+    task_pool_.start([this, path, progress] {
+        auto accounts = core::parse_import_file(path, [progress](std::int64_t done, std::int64_t total) {
+            const auto percent = static_cast<int>(done * 100 / std::max<std::int64_t>(total, 1));
+            QMetaObject::invokeMethod(progress, [progress, percent] { progress->setValue(percent); }, Qt::QueuedConnection);
+        });
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, progress, accounts = std::move(accounts)] {
+                progress->deleteLater();
+
+                if (!accounts) {
+                    const auto message = QString::fromStdString(std::string(core::import_error_as_string(accounts.error())));
+                    QMessageBox::critical(this, "Import Error", message);
+                    return;
+                }
 
-    auto *item = accounts_table_->item(row, column);
-    if (!item) return;
+                const auto summary = account_store_->import_accounts(*accounts);
+                handle_table_selection_changed();
 
-    const QString new_value = item->text();
-    switch (column) {
-    case 0: updated_account.note = new_value; break;
-    case 1: updated_account.username = new_value; break;
-    case 2:
-        updated_account.password = new_value;
-        accounts_table_->blockSignals(true);
-        item->setData(Qt::UserRole, new_value);
-        item->setText("************");
-        accounts_table_->blockSignals(false);
-        break;
-    }
+                const auto message = QString{"Imported %1 accounts.\nSkipped %2 existing usernames and %3 incomplete entries."}
+                                         .arg(summary.added)
+                                         .arg(summary.duplicates)
+                                         .arg(summary.incomplete);
+                QMessageBox::information(this, "Import Accounts", message);
+            },
+            Qt::QueuedConnection);
+    });
+}
 
-    if (!account_config_->update_account(row, updated_account)) {
-        QMessageBox::critical(this, "Save Error", "Failed to save changes to the account");
-        refresh_accounts_table();
-    } else {
-        accounts_cache_[row] = updated_account;
-    }
+auto Window::handle_export_accounts_request() -> void
+{
+    const auto path = QFileDialog::getSaveFileName(this, "Export Accounts", QDir::homePath() + "/accounts.csv",
+                                                   "CSV (*.csv);;JSON (*.json);;TOML (*.toml)");
+    if (path.isEmpty()) return;
+
+    // the copy shares the store's arenas, so edits made meanwhile do not affect the export
+    task_pool_.start([this, path, accounts = account_store_->accounts()] {
+        const auto written = core::export_accounts(accounts, path);
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, written] {
+                if (!written) {
+                    const auto message = QString::fromStdString(std::string(core::export_error_as_string(written.error())));
+                    QMessageBox::critical(this, "Export Error", message);
+                    return;
+                }
+
+                QMessageBox::information(this, "Export Accounts", QString{"Exported %1 accounts."}.arg(*written));
+            },
+            Qt::QueuedConnection);
+    });
 }
 
 auto Window::setup_home_page() -> void
@@ -642,27 +837,51 @@ auto Window::setup_accounts_page() -> void
 {
     auto *accounts_layout = new QVBoxLayout{accounts_page_};
 
-    accounts_table_->setHorizontalHeaderLabels({"Note", "Username", "Password"});
+    accounts_table_->setModel(accounts_model_);
 
     accounts_table_->horizontalHeader()->setStretchLastSection(false);
     accounts_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
+    // fixed row heights let the view place any row without asking the model for its contents
     accounts_table_->verticalHeader()->setVisible(false);
+    accounts_table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    accounts_table_->verticalHeader()->setDefaultSectionSize(ACCOUNT_ROW_HEIGHT);
 
     accounts_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    accounts_table_->setSelectionMode(QAbstractItemView::SingleSelection);
     accounts_table_->setEditTriggers(QAbstractItemView::DoubleClicked);
     accounts_table_->setShowGrid(true);
 
-    QMainWindow::connect(accounts_table_, &QTableWidget::cellChanged, this, &Window::handle_account_cell_updated);
+    // keep the stored order until a header is clicked
+    accounts_table_->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    accounts_table_->setSortingEnabled(true);
+
+    account_search_edit_->setPlaceholderText("Search by note or username");
+    account_search_edit_->setClearButtonEnabled(true);
+    QMainWindow::connect(account_search_edit_, &QLineEdit::textChanged, this, &Window::refresh_accounts_table);
+    accounts_layout->addWidget(account_search_edit_);
+
+    QMainWindow::connect(accounts_model_, &Accounts_Table_Model::update_failed, this,
+                         [this] { QMessageBox::critical(this, "Save Error", "Failed to save changes to the account"); });
     accounts_layout->addWidget(accounts_table_, 1);
 
-    QMainWindow::connect(accounts_table_, &QTableWidget::itemSelectionChanged, this, &Window::handle_table_selection_changed);
+    QMainWindow::connect(accounts_table_->selectionModel(), &QItemSelectionModel::selectionChanged, this,
+                         &Window::handle_table_selection_changed);
     refresh_accounts_table();
 }
 
 auto Window::reset_account_selection() -> void
 {
-    accounts_table_->setCurrentCell(-1, -1);
+    accounts_table_->selectionModel()->clear();
+}
+
+auto Window::select_account(core::Account_Id id) -> void
+{
+    const auto row = accounts_model_->row_of(id);
+    if (row < 0) return;
+
+    accounts_table_->selectRow(row);
+    accounts_table_->scrollTo(accounts_model_->index(row, 0));
 }
 
 auto Window::update_bottom_bar_content(riot::Game game) -> void
@@ -676,7 +895,7 @@ auto Window::update_bottom_bar_content(riot::Game game) -> void
     case riot::Game::Legends_of_Runeterra: icon_filename = "runeterra-icon.png"; break;
     }
 
-    control_bar_->update_game_context(game, game_icons_dir_ + icon_filename);
+    control_bar_->update_game_context(game, "icons/" + icon_filename);
 }
 
 auto Window::create_banner_button(const QString &image_path, riot::Game game) -> QPushButton *
@@ -684,9 +903,23 @@ auto Window::create_banner_button(const QString &image_path, riot::Game game) ->
     auto *button = new QPushButton{"", home_page_};
     button->setObjectName("banner_button");
 
-    const QPixmap original_pixmap(banners_dir_ + image_path);
-    banner_pixmaps_[game] = original_pixmap;
-    button->setIcon(QIcon(original_pixmap));
+    // banners never grow past the screen, so that is the size kept in the thumbnail cache
+    const auto *current_screen = QMainWindow::screen();
+    const auto thumbnail_size = current_screen ? current_screen->availableSize() : QSize{1920, 1080};
+
+    // decoding runs off the UI thread; the button keeps its size and gets the image once it is ready
+    task_pool_.start([this, game, name = ("banners/" + image_path).toStdString(), thumbnail_size] {
+        auto pyramid = Mip_Pyramid{load_thumbnail(core::Asset_Pack::application().find(name), thumbnail_size, 1.0)};
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, game, pyramid = std::move(pyramid)] {
+                banner_pyramids_[game] = pyramid;
+                update_banner_sizes(Qt::SmoothTransformation);
+            },
+            Qt::QueuedConnection);
+    });
+
     return button;
 }
 
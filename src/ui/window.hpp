@@ -5,12 +5,17 @@
 #pragma once
 
 #include "core/account.hpp"
+#include "core/account_store.hpp"
 #include "core/theme.hpp"
+#include "core/theme_service.hpp"
 #include "riot/client.hpp"
 #include "theme_editor.hpp"
+#include "ui/accounts_table_model.hpp"
 #include "ui/control_bar.hpp"
 #include "ui/login_worker.hpp"
+#include "ui/mip_pyramid.hpp"
 #include "ui/misc_bar.hpp"
+#include "ui/theme_style.hpp"
 #include "ui/title_bar.hpp"
 #include "updater.hpp"
 
@@ -19,6 +24,7 @@
 #include <QHeaderView>
 #include <QKeyEvent>
 #include <QLabel>
+#include <QLineEdit>
 #include <QMainWindow>
 #include <QMap>
 #include <QMenu>
@@ -29,8 +35,10 @@
 #include <QPushButton>
 #include <QStackedWidget>
 #include <QString>
-#include <QTableWidget>
+#include <QTableView>
 #include <QThread>
+#include <QThreadPool>
+#include <QTimer>
 #include <QWidget>
 
 #define TOML_EXCEPTIONS 0
@@ -92,19 +100,23 @@ class Window final : public QMainWindow {
     /// @brief Handles the final result of the login attempt.
     auto on_login_finished(bool success, const QString &message) -> void;
 
-    /// @brief Reloads and repopulates the accounts table from the configuration.
+    /// @brief Re-runs the search query over the in-memory account store.
     auto refresh_accounts_table() -> void;
 
     /// @brief Handles the title bar's home button click to return to the main page.
     auto handle_home_button_click() -> void;
 
   private:
-    /// @brief Generates a full stylesheet string from a theme configuration.
+    /// @brief Returns the full stylesheet for a theme, reusing the cached render when the theme is unchanged.
     auto generate_stylesheet(const core::Theme &theme) -> QString;
 
-    /// @brief Applies the current theme's stylesheet to the application.
+    /// @brief Applies the current theme through the selected backend.
+    /// @note The time taken is logged under the "friede.theme.timing" category, which is off by default.
     auto apply_theme() -> void;
 
+    /// @brief Switches between the stylesheet and the native theming backend.
+    auto set_theme_backend(Theme_Backend backend) -> void;
+
     /// @brief Handles the action to open the theme customization dialog.
     auto handle_customize_theme_button_click() -> void;
 
@@ -123,8 +135,11 @@ class Window final : public QMainWindow {
     /// @brief Handles the remove account button click action.
     auto handle_remove_account_button_click() -> void;
 
-    /// @brief Saves changes to an account after a cell is edited in the table.
-    auto handle_account_cell_updated(int row, int column) -> void;
+    /// @brief Asks for a CSV, JSON or TOML file and imports its accounts in the background.
+    auto handle_import_accounts_request() -> void;
+
+    /// @brief Asks for a destination file and streams every account to it in the background.
+    auto handle_export_accounts_request() -> void;
 
     /// @brief Initializes the main home page with game selection banners.
     auto setup_home_page() -> void;
@@ -135,6 +150,21 @@ class Window final : public QMainWindow {
     /// @brief Clears the current selection in the accounts table.
     auto reset_account_selection() -> void;
 
+    /// @brief Selects the table row showing an account and scrolls it into view.
+    auto select_account(core::Account_Id id) -> void;
+
+    /// @brief Rescales the banner buttons to the space available on the home page.
+    auto update_banner_sizes(Qt::TransformationMode mode) -> void;
+
+    /// @brief Returns the window edges within the resize margin of a position.
+    auto resize_edges_at(const QPoint &position) const -> Qt::Edges;
+
+    /// @brief Switches between system-driven and hand-rolled window moves and resizes.
+    auto set_system_window_drag(bool enabled) -> void;
+
+    /// @brief Applies the pending drag geometry and holds further updates back for a frame.
+    auto apply_pending_geometry() -> void;
+
     /// @brief Factory method to create a game banner button.
     auto create_banner_button(const QString &image_path, riot::Game game) -> QPushButton *;
 
@@ -145,16 +175,30 @@ class Window final : public QMainWindow {
     Updater *updater_;
 
     core::Theme_Config *theme_config_;
+
+    /// @brief The in-memory theme; paint and resize paths read it instead of the file.
+    core::Theme_Service *theme_service_;
+
+    /// @brief How the theme is applied; the stylesheet is the default.
+    Theme_Backend theme_backend_;
+
+    /// @brief The application palette the stylesheet backend runs on, restored when leaving the native backend.
+    QPalette stylesheet_palette_;
+
     core::Account_Config *account_config_;
 
+    /// @brief The resident account list; reads never touch the disk.
+    core::Account_Store *account_store_;
+
     /// @brief The background thread for executing the Login_Worker.
     QThread worker_thread_;
 
-    /// @brief An in-memory cache of accounts to avoid frequent file I/O.
-    QVector<core::Account> accounts_cache_;
+    /// @brief Runs the imports, exports and banner decodes; drained before the window goes away
+    /// so that no task outlives the widgets it reports back to.
+    QThreadPool task_pool_;
 
-    /// @brief A cache of the original banner images for high-quality resizing.
-    QMap<riot::Game, QPixmap> banner_pixmaps_;
+    /// @brief The banner images at halved sizes; resizes scale from the nearest larger level.
+    QMap<riot::Game, Mip_Pyramid> banner_pyramids_;
 
     /// @brief The game currently selected by the user from the home page.
     riot::Game current_game_;
@@ -165,8 +209,23 @@ class Window final : public QMainWindow {
     /// @brief Stores the initial mouse position for drag/resize calculations.
     QPoint mouse_click_position_;
 
-    QString banners_dir_;
-    QString game_icons_dir_;
+    /// @brief Whether edge and title bar drags are handed to the windowing system.
+    bool system_window_drag_;
+
+    /// @brief Whether an edge drag is resizing the window; banners are scaled fast while it is.
+    bool resize_drag_active_;
+
+    /// @brief Whether the current resize drag is driven by the windowing system.
+    bool system_resize_active_;
+
+    /// @brief The latest geometry requested by an edge drag, applied at most once per frame.
+    QRect pending_geometry_;
+
+    /// @brief Runs for one frame after a geometry update; further drag updates wait for it.
+    QTimer *geometry_update_timer_;
+
+    /// @brief Fires once the window size has settled to redo the banners with smooth scaling.
+    QTimer *banner_settle_timer_;
 
     QStackedWidget *main_stacked_widget_;
     QWidget *home_page_;
@@ -178,7 +237,12 @@ class Window final : public QMainWindow {
     Title_Bar *title_bar_;
     Control_Bar *control_bar_;
 
-    QTableWidget *accounts_table_;
+    /// @brief Filters the accounts table: substring matches first, then fuzzy trigram matches for queries of 3+ bytes.
+    QLineEdit *account_search_edit_;
+    QTableView *accounts_table_;
+
+    /// @brief Serves the table straight from the account store; only visible rows are ever read.
+    Accounts_Table_Model *accounts_model_;
 
     QLabel *progress_status_label_;
     QPushButton *progress_back_button_;